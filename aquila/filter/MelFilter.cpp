@@ -27,7 +27,7 @@ namespace Aquila
      * @param sampleFrequency sample frequency in Hz
      */
     MelFilter::MelFilter(FrequencyType sampleFrequency):
-        m_sampleFrequency(sampleFrequency), m_spectrum()
+        m_sampleFrequency(sampleFrequency), m_firstBin(0), m_weights()
     {
     }
 
@@ -38,7 +38,7 @@ namespace Aquila
      */
     MelFilter::MelFilter(MelFilter&& other):
         m_sampleFrequency(other.m_sampleFrequency),
-        m_spectrum(std::move(other.m_spectrum))
+        m_firstBin(other.m_firstBin), m_weights(std::move(other.m_weights))
     {
     }
 
@@ -51,7 +51,8 @@ namespace Aquila
     MelFilter& MelFilter::operator=(const MelFilter& other)
     {
         m_sampleFrequency = other.m_sampleFrequency;
-        m_spectrum = other.m_spectrum;
+        m_firstBin = other.m_firstBin;
+        m_weights = other.m_weights;
         return *this;
     }
 
@@ -89,23 +90,34 @@ namespace Aquila
     double MelFilter::apply(const SpectrumType& dataSpectrum) const
     {
         double value = 0.0;
-        const std::size_t N = dataSpectrum.size();
-        for (std::size_t i = 0; i < N; ++i)
+        // filter covers only the bins up to Nyquist frequency
+        const std::size_t N = std::min(dataSpectrum.size(),
+                                       m_firstBin + m_weights.size());
+        for (std::size_t i = m_firstBin; i < N; ++i)
         {
-            value += std::abs(dataSpectrum[i]) * m_spectrum[i];
+            value += std::abs(dataSpectrum[i]) * m_weights[i - m_firstBin];
         }
         return value;
     }
 
+    /**
+     * Returns a dot product of power spectrum and Mel filter spectrum.
+     *
+     * @param dataPSpec power spectrum of the signal
+     * @return dot product of the spectra
+     */
     double MelFilter::apply(const std::vector<double>& dataPSpec) const
     {
         double value = 0.0;
-        for (std::size_t i = 0; i < dataPSpec.size(); ++i)
+        const std::size_t N = std::min(dataPSpec.size(),
+                                       m_firstBin + m_weights.size());
+        for (std::size_t i = m_firstBin; i < N; ++i)
         {
-            value += dataPSpec[i] * m_spectrum[i];
+            value += dataPSpec[i] * m_weights[i - m_firstBin];
         }
         return value;
     }
+
     /**
      * Generates a vector of values shaped as a triangular filter.
      *
@@ -126,8 +138,8 @@ namespace Aquila
                                            FrequencyType maxFreq, std::size_t N)
     {
         const std::size_t spec_len = (int)std::ceil(N/2.) + 1;
-        m_spectrum.clear();
-        m_spectrum.resize(spec_len, 0.0);
+        m_firstBin = 0;
+        m_weights.clear();
 
         // find spectral peak positions corresponding to frequencies
         std::size_t minPos = static_cast<std::size_t>((N+1) * minFreq / m_sampleFrequency);
@@ -139,16 +151,16 @@ namespace Aquila
             return;
         }
 
-        const double max = 1.0;
-
-        // outside the triangle spectrum values are 0, guaranteed by
-        // earlier call to resize
+        // outside the triangle spectrum values are 0, so only the
+        // [minPos, maxPos] range is stored
+        m_firstBin = minPos;
+        m_weights.resize(maxPos - minPos + 1, 0.0);
         for (std::size_t k = minPos; k <= maxPos; ++k)
         {
             if(k < cntrPos)
-                m_spectrum[k] = (k - minPos)/(double)(cntrPos - minPos);
+                m_weights[k - minPos] = (k - minPos)/(double)(cntrPos - minPos);
             if(k >= cntrPos)
-                m_spectrum[k] = (maxPos - k)/(double)(maxPos - cntrPos);
+                m_weights[k - minPos] = (maxPos - k)/(double)(maxPos - cntrPos);
         }
     }
 }
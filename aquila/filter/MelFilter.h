@@ -73,13 +73,39 @@ namespace Aquila
             return m_sampleFrequency;
         }
 
+        /**
+         * Returns index of the spectral bin where the filter starts.
+         *
+         * @return index of the bin matching first of the weights
+         */
+        std::size_t getFirstBin() const
+        {
+            return m_firstBin;
+        }
+
+        /**
+         * Returns the filter spectrum within its non-zero range.
+         *
+         * @return weights of consecutive bins, starting from getFirstBin()
+         */
+        const std::vector<double>& getWeights() const
+        {
+            return m_weights;
+        }
+
     private:
         FrequencyType m_sampleFrequency;
 
         /**
-         * Filter spectrum (real-valued).
+         * Index of the first bin covered by the triangle.
+         */
+        std::size_t m_firstBin;
+
+        /**
+         * Filter spectrum (real-valued) from m_firstBin to the end of
+         * the triangle; all the other bins are zero.
          */
-        std::vector<double> m_spectrum;
+        std::vector<double> m_weights;
 
         void generateFilterSpectrum(FrequencyType minFreq,
                                     FrequencyType centerFreq,
@@ -16,9 +16,21 @@
  */
 
 #include "MelFilterBank.h"
+#include "../simd.h"
+#include <algorithm>
+#include <cmath>
 
 namespace Aquila
 {
+    namespace
+    {
+        /**
+         * Minimal number of multiply-adds in a batch worth splitting
+         * between threads.
+         */
+        const std::size_t PARALLEL_BATCH_TAPS = 32768;
+    }
+
     /**
      * Creates all the filters in the bank.
      *
@@ -31,13 +43,20 @@ namespace Aquila
                                  std::size_t length,
                                  FrequencyType melFilterWidth,
                                  std::size_t bankSize):
-        m_filters(), m_sampleFrequency(sampleFrequency), N(length)
+        m_weights(), m_rowStarts(), m_firstBins(),
+        m_sampleFrequency(sampleFrequency), N(length)
     {
-        m_filters.reserve(bankSize);
+        m_rowStarts.reserve(bankSize + 1);
+        m_firstBins.reserve(bankSize);
+        m_rowStarts.push_back(0);
         for (std::size_t i = 0; i < bankSize; ++i)
         {
-            m_filters.push_back(MelFilter(m_sampleFrequency));
-            m_filters[i].createFilter(i, melFilterWidth, N);
+            MelFilter filter(m_sampleFrequency);
+            filter.createFilter(i, melFilterWidth, N);
+            const std::vector<double>& weights = filter.getWeights();
+            m_weights.insert(m_weights.end(), weights.begin(), weights.end());
+            m_rowStarts.push_back(m_weights.size());
+            m_firstBins.push_back(filter.getFirstBin());
         }
     }
 
@@ -52,18 +71,82 @@ namespace Aquila
         std::vector<double> output(size(), 0.0);
         for (std::size_t i = 0; i < size(); ++i)
         {
-            output[i] = m_filters[i].apply(frameSpectrum);
+            const std::size_t first = m_firstBins[i];
+            const std::size_t last = std::min(frameSpectrum.size(),
+                first + m_rowStarts[i + 1] - m_rowStarts[i]);
+            const double* weights = m_weights.data() + m_rowStarts[i];
+            for (std::size_t k = first; k < last; ++k)
+            {
+                output[i] += std::abs(frameSpectrum[k]) * weights[k - first];
+            }
         }
         return output;
     }
 
+    /**
+     * Processes power spectrum of a frame through all filters.
+     *
+     * @param framePSpec power spectrum of the frame
+     * @return vector of results (one value per each filter)
+     */
     std::vector<double> MelFilterBank::applyAll(const std::vector<double>& framePSpec) const
     {
         std::vector<double> output(size(), 0.0);
-        for (std::size_t i = 0; i < size(); ++i)
+        applyAll(framePSpec.data(), framePSpec.size(), 1, output.data());
+        return output;
+    }
+
+    /**
+     * Processes power spectra of many frames through all filters.
+     *
+     * Spectra are stored one after another, spectrumSize values each;
+     * filter weights beyond spectrumSize are ignored. Results for i-th
+     * frame are written to out + i * size(). Large batches are split
+     * between threads.
+     *
+     * @param powerSpectra power spectra of all frames
+     * @param spectrumSize number of bins in each power spectrum
+     * @param count number of frames
+     * @param out output buffer (room for count * size() values)
+     */
+    void MelFilterBank::applyAll(const double* powerSpectra,
+                                 std::size_t spectrumSize, std::size_t count,
+                                 double* out) const
+    {
+        const std::size_t filters = size();
+        const long frames = static_cast<long>(count);
+        #pragma omp parallel for if(count * m_weights.size() >= PARALLEL_BATCH_TAPS)
+        for (long i = 0; i < frames; ++i)
         {
-            output[i] = m_filters[i].apply(framePSpec);
+            const double* powerSpectrum = powerSpectra + i * spectrumSize;
+            for (std::size_t j = 0; j < filters; ++j)
+            {
+                out[i * filters + j] = applyFilter(j, powerSpectrum,
+                                                   spectrumSize);
+            }
         }
-        return output;
+    }
+
+    /**
+     * Calculates output of a single filter.
+     *
+     * @param filter index of the filter
+     * @param powerSpectrum power spectrum of the frame
+     * @param spectrumSize number of bins in the power spectrum
+     * @return dot product of the spectrum and filter weights
+     */
+    double MelFilterBank::applyFilter(std::size_t filter,
+                                      const double* powerSpectrum,
+                                      std::size_t spectrumSize) const
+    {
+        const std::size_t first = m_firstBins[filter];
+        if (first >= spectrumSize)
+        {
+            return 0.0;
+        }
+        const std::size_t length = std::min(spectrumSize - first,
+            m_rowStarts[filter + 1] - m_rowStarts[filter]);
+        return dotProduct(m_weights.data() + m_rowStarts[filter],
+                          powerSpectrum + first, length);
     }
 }
@@ -26,7 +26,14 @@
 namespace Aquila
 {
     /**
-     * A wrapper class for a vector of triangular filters.
+     * A bank of triangular Mel filters, stored as a sparse matrix.
+     *
+     * Each filter is non-zero only within a few dozen bins, so the bank
+     * keeps just these ranges, in compressed sparse row (CSR) layout:
+     * weights of all filters lie one after another in a single buffer,
+     * and for every filter the index of its first weight and of the
+     * spectral bin it applies to are stored. Applying the bank costs as
+     * many multiply-adds as there are non-zero weights.
      */
     class AQUILA_EXPORT MelFilterBank
     {
@@ -37,6 +44,8 @@ namespace Aquila
 
         std::vector<double> applyAll(const SpectrumType &frameSpectrum) const;
         std::vector<double> applyAll(const std::vector<double>& framePSpec) const;
+        void applyAll(const double* powerSpectra, std::size_t spectrumSize,
+                      std::size_t count, double* out) const;
 
         /**
          * Returns sample frequency of all filters.
@@ -57,13 +66,34 @@ namespace Aquila
          *
          * @return number of filters
          */
-        std::size_t size() const { return m_filters.size(); }
+        std::size_t size() const { return m_firstBins.size(); }
+
+        /**
+         * Returns the number of stored (non-zero range) filter weights.
+         *
+         * @return total number of weights of all filters
+         */
+        std::size_t getWeightsCount() const { return m_weights.size(); }
 
     private:
+        double applyFilter(std::size_t filter, const double* powerSpectrum,
+                           std::size_t spectrumSize) const;
+
+        /**
+         * Weights of all filters, one filter after another.
+         */
+        std::vector<double> m_weights;
+
+        /**
+         * Index of the first weight of each filter; the last element
+         * is one past the last weight of the last filter.
+         */
+        std::vector<std::size_t> m_rowStarts;
+
         /**
-         * Vector of Mel filters.
+         * Spectral bin matching the first weight of each filter.
          */
-        std::vector<MelFilter> m_filters;
+        std::vector<std::size_t> m_firstBins;
 
         /**
          * Sample frequency of the filtered signal.
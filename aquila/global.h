@@ -46,10 +46,17 @@ namespace Aquila
      */
     const char* const VERSION_STRING = "3.0.0-dev";
 
+#ifdef AQUILA_USE_FLOAT
+    /**
+     * Sample value type - single precision in a float build.
+     */
+    typedef float SampleType;
+#else
     /**
      * Sample value type.
      */
     typedef double SampleType;
+#endif
 
     /**
      * Sample frequency type.
@@ -57,9 +64,9 @@ namespace Aquila
     typedef double FrequencyType;
 
     /**
-     * Our standard complex number type, using double precision.
+     * Our standard complex number type, with the same precision as samples.
      */
-    typedef std::complex<double> ComplexType;
+    typedef std::complex<SampleType> ComplexType;
 
     /**
      * Spectrum type - a vector of complex values.
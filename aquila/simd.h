@@ -0,0 +1,90 @@
+/**
+ * @file simd.h
+ *
+ * Detection of vector instruction sets and shared vector helpers.
+ *
+ * This is an internal header, included only by implementation files.
+ * It defines AQUILA_HAVE_SSE2 or AQUILA_HAVE_NEON when the compiler
+ * targets one of these instruction sets and includes its intrinsics.
+ * Instruction sets which may be missing at runtime (AVX2) are not
+ * handled here; their code lives in separate files.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define AQUILA_HAVE_SSE2
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define AQUILA_HAVE_NEON
+#endif
+
+namespace Aquila
+{
+    /**
+     * Helpers are declared in an anonymous namespace, so that copies
+     * compiled with different instruction sets never get merged by
+     * the linker.
+     */
+    namespace
+    {
+        /**
+         * Calculates a dot product of two arrays.
+         *
+         * @param a first array
+         * @param b second array
+         * @param length number of values
+         * @return dot product
+         */
+        inline double dotProduct(const double* a, const double* b,
+                                 std::size_t length)
+        {
+            std::size_t k = 0;
+            double sum = 0.0;
+#if defined(AQUILA_HAVE_SSE2)
+            __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+            for (; k + 4 <= length; k += 4)
+            {
+                acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(a + k),
+                                                   _mm_loadu_pd(b + k)));
+                acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(a + k + 2),
+                                                   _mm_loadu_pd(b + k + 2)));
+            }
+            double partial[2];
+            _mm_storeu_pd(partial, _mm_add_pd(acc0, acc1));
+            sum = partial[0] + partial[1];
+#elif defined(AQUILA_HAVE_NEON)
+            float64x2_t acc0 = vdupq_n_f64(0.0), acc1 = vdupq_n_f64(0.0);
+            for (; k + 4 <= length; k += 4)
+            {
+                acc0 = vfmaq_f64(acc0, vld1q_f64(a + k), vld1q_f64(b + k));
+                acc1 = vfmaq_f64(acc1, vld1q_f64(a + k + 2),
+                                 vld1q_f64(b + k + 2));
+            }
+            sum = vaddvq_f64(vaddq_f64(acc0, acc1));
+#endif
+            for (; k < length; ++k)
+            {
+                sum += a[k] * b[k];
+            }
+            return sum;
+        }
+    }
+}
+
+#endif // SIMD_H
@@ -21,9 +21,12 @@
 
 #include "source/SignalSource.h"
 #include "source/Frame.h"
+#include "source/FrameView.h"
 #include "source/FramesCollection.h"
 #include "source/PlainTextFile.h"
 #include "source/RawPcmFile.h"
+#include "source/MappedWaveFile.h"
+#include "source/PcmDecoder.h"
 #include "source/WaveFile.h"
 #include "source/WaveFileHandler.h"
 #include "source/generator/Generator.h"
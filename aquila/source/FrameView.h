@@ -0,0 +1,409 @@
+/**
+ * @file FrameView.h
+ *
+ * Non-owning views of signal frames.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#ifndef FRAMEVIEW_H
+#define FRAMEVIEW_H
+
+#include "../global.h"
+#include "SignalSource.h"
+#include <cstddef>
+#include <iterator>
+
+namespace Aquila
+{
+    /**
+     * A view of a single frame: a pointer to its first sample and length.
+     *
+     * Unlike Frame, a view is not a SignalSource. It has no virtual
+     * methods and no members besides the pointer and length, so it can
+     * be created for free and passed by value. Samples are contiguous,
+     * and begin()/end() are plain pointers.
+     *
+     * The view doesn't own the samples; the source must outlive it.
+     */
+    class AQUILA_EXPORT FrameView
+    {
+    public:
+        /**
+         * Creates a view of length samples starting at data.
+         *
+         * @param data pointer to the first sample
+         * @param length number of samples
+         */
+        FrameView(const SampleType* data = nullptr, std::size_t length = 0):
+            m_data(data), m_length(length)
+        {
+        }
+
+        /**
+         * Returns the pointer to the first sample.
+         *
+         * @return frame samples
+         */
+        const SampleType* data() const
+        {
+            return m_data;
+        }
+
+        /**
+         * Returns the frame length.
+         *
+         * @return number of samples
+         */
+        std::size_t size() const
+        {
+            return m_length;
+        }
+
+        /**
+         * Returns a sample of the frame.
+         *
+         * @param position index of the sample in the frame
+         * @return sample value
+         */
+        SampleType operator[](std::size_t position) const
+        {
+            return m_data[position];
+        }
+
+        /**
+         * Returns a pointer to the first sample.
+         *
+         * @return iterator
+         */
+        const SampleType* begin() const
+        {
+            return m_data;
+        }
+
+        /**
+         * Returns a pointer one past the last sample.
+         *
+         * @return iterator
+         */
+        const SampleType* end() const
+        {
+            return m_data + m_length;
+        }
+
+    private:
+        /**
+         * First sample of the frame.
+         */
+        const SampleType* m_data;
+
+        /**
+         * Number of samples.
+         */
+        std::size_t m_length;
+    };
+
+    /**
+     * Views of all full frames of a signal.
+     *
+     * The frames are described only by the first sample, frame length
+     * and hop (distance between frame beginnings), so dividing even
+     * a very long signal into frames takes constant time and memory.
+     * Frames are laid out in the same way as in FramesCollection.
+     *
+     * FrameViews views(wav, 512, 256);
+     * for (auto frame : views) {
+     *     // frame.data(), frame.size(), range-for over samples...
+     * }
+     */
+    class AQUILA_EXPORT FrameViews
+    {
+    public:
+        class iterator;
+
+        /**
+         * Creates an empty range.
+         */
+        FrameViews():
+            m_data(nullptr), m_length(0), m_hop(0), m_count(0)
+        {
+        }
+
+        /**
+         * Divides a contiguous signal into frames.
+         *
+         * @param data first sample of the signal
+         * @param signalLength number of samples in the signal
+         * @param samplesPerFrame frame length
+         * @param samplesPerOverlap how many samples are common to adjacent frames
+         */
+        FrameViews(const SampleType* data, std::size_t signalLength,
+                   std::size_t samplesPerFrame,
+                   std::size_t samplesPerOverlap = 0):
+            m_data(data), m_length(samplesPerFrame),
+            m_hop(samplesPerFrame - samplesPerOverlap), m_count(0)
+        {
+            if (samplesPerOverlap < samplesPerFrame && signalLength >= m_length)
+            {
+                m_count = (signalLength - m_length) / m_hop + 1;
+            }
+        }
+
+        /**
+         * Divides a signal source into frames.
+         *
+         * @param source a reference to source object
+         * @param samplesPerFrame frame length
+         * @param samplesPerOverlap how many samples are common to adjacent frames
+         */
+        FrameViews(const SignalSource& source, std::size_t samplesPerFrame,
+                   std::size_t samplesPerOverlap = 0):
+            FrameViews(source.toArray(), source.getSamplesCount(),
+                       samplesPerFrame, samplesPerOverlap)
+        {
+        }
+
+        /**
+         * Returns number of frames.
+         *
+         * @return frame count
+         */
+        std::size_t size() const
+        {
+            return m_count;
+        }
+
+        /**
+         * Returns number of samples in each frame.
+         *
+         * @return frame length
+         */
+        std::size_t getSamplesPerFrame() const
+        {
+            return m_length;
+        }
+
+        /**
+         * Returns the distance between beginnings of adjacent frames.
+         *
+         * @return hop in samples
+         */
+        std::size_t getHop() const
+        {
+            return m_hop;
+        }
+
+        /**
+         * Returns view of nth frame.
+         *
+         * @param index frame number
+         * @return frame view
+         */
+        FrameView operator[](std::size_t index) const
+        {
+            return FrameView(m_data + index * m_hop, m_length);
+        }
+
+        iterator begin() const;
+        iterator end() const;
+
+        /**
+         * Random access iterator over frame views.
+         */
+        class AQUILA_EXPORT iterator
+        {
+        public:
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef FrameView value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const FrameView* pointer;
+            typedef FrameView reference;
+
+            /**
+             * Creates an iterator pointing to a frame.
+             *
+             * @param data first sample of the frame
+             * @param length frame length
+             * @param hop distance between frame beginnings
+             */
+            explicit iterator(const SampleType* data = nullptr,
+                              std::size_t length = 0, std::size_t hop = 0):
+                m_data(data), m_length(length),
+                m_hop(static_cast<std::ptrdiff_t>(hop))
+            {
+            }
+
+            /**
+             * Returns view of the current frame.
+             *
+             * @return frame view
+             */
+            FrameView operator*() const
+            {
+                return FrameView(m_data, m_length);
+            }
+
+            /**
+             * Returns view of a frame at given distance.
+             *
+             * @param n distance from the current frame
+             * @return frame view
+             */
+            FrameView operator[](std::ptrdiff_t n) const
+            {
+                return FrameView(m_data + n * m_hop, m_length);
+            }
+
+            iterator& operator++()
+            {
+                m_data += m_hop;
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                iterator tmp(*this);
+                m_data += m_hop;
+                return tmp;
+            }
+
+            iterator& operator--()
+            {
+                m_data -= m_hop;
+                return *this;
+            }
+
+            iterator operator--(int)
+            {
+                iterator tmp(*this);
+                m_data -= m_hop;
+                return tmp;
+            }
+
+            iterator& operator+=(std::ptrdiff_t n)
+            {
+                m_data += n * m_hop;
+                return *this;
+            }
+
+            iterator& operator-=(std::ptrdiff_t n)
+            {
+                m_data -= n * m_hop;
+                return *this;
+            }
+
+            iterator operator+(std::ptrdiff_t n) const
+            {
+                return iterator(m_data + n * m_hop, m_length, m_hop);
+            }
+
+            iterator operator-(std::ptrdiff_t n) const
+            {
+                return iterator(m_data - n * m_hop, m_length, m_hop);
+            }
+
+            std::ptrdiff_t operator-(const iterator& other) const
+            {
+                return m_hop ? (m_data - other.m_data) / m_hop : 0;
+            }
+
+            bool operator==(const iterator& other) const
+            {
+                return m_data == other.m_data;
+            }
+
+            bool operator!=(const iterator& other) const
+            {
+                return !operator==(other);
+            }
+
+            bool operator<(const iterator& other) const
+            {
+                return m_data < other.m_data;
+            }
+
+            bool operator>(const iterator& other) const
+            {
+                return m_data > other.m_data;
+            }
+
+            bool operator<=(const iterator& other) const
+            {
+                return m_data <= other.m_data;
+            }
+
+            bool operator>=(const iterator& other) const
+            {
+                return m_data >= other.m_data;
+            }
+
+        private:
+            /**
+             * First sample of the current frame.
+             */
+            const SampleType* m_data;
+
+            /**
+             * Frame length.
+             */
+            std::size_t m_length;
+
+            /**
+             * Distance between frame beginnings.
+             */
+            std::ptrdiff_t m_hop;
+        };
+
+    private:
+        /**
+         * First sample of the signal.
+         */
+        const SampleType* m_data;
+
+        /**
+         * Frame length.
+         */
+        std::size_t m_length;
+
+        /**
+         * Distance between frame beginnings.
+         */
+        std::size_t m_hop;
+
+        /**
+         * Number of full frames.
+         */
+        std::size_t m_count;
+    };
+
+    /**
+     * Returns an iterator pointing to the first frame.
+     *
+     * @return iterator
+     */
+    inline FrameViews::iterator FrameViews::begin() const
+    {
+        return iterator(m_data, m_length, m_hop);
+    }
+
+    /**
+     * Returns an iterator pointing one past the last frame.
+     *
+     * @return iterator
+     */
+    inline FrameViews::iterator FrameViews::end() const
+    {
+        return iterator(m_data + m_count * m_hop, m_length, m_hop);
+    }
+}
+
+#endif // FRAMEVIEW_H
@@ -24,7 +24,7 @@ namespace Aquila
      * Creates an empty frames collection.
      */
     FramesCollection::FramesCollection():
-        m_frames(), m_samplesPerFrame(0)
+        m_frames(), m_views(), m_samplesPerFrame(0)
     {
     }
 
@@ -38,7 +38,7 @@ namespace Aquila
     FramesCollection::FramesCollection(const SignalSource& source,
                                        unsigned int samplesPerFrame,
                                        unsigned int samplesPerOverlap):
-        m_frames(), m_samplesPerFrame(0)
+        m_frames(), m_views(), m_samplesPerFrame(0)
     {
         divideFrames(source, samplesPerFrame, samplesPerOverlap);
     }
@@ -90,22 +90,17 @@ namespace Aquila
             return;
         }
         m_samplesPerFrame = samplesPerFrame;
-        const std::size_t sourceSize = source.getSamplesCount();
-        const unsigned int nonOverlapped = samplesPerFrame - samplesPerOverlap;
-        const unsigned int framesCount = sourceSize / nonOverlapped;
+        m_views = FrameViews(source, samplesPerFrame, samplesPerOverlap);
 
+        const std::size_t framesCount = m_views.size();
+        const std::size_t nonOverlapped = m_views.getHop();
         m_frames.reserve(framesCount);
-        unsigned int indexBegin = 0, indexEnd = 0;
         for (std::size_t i = 0; i < framesCount; ++i)
         {
-            // calculate each frame boundaries
-            // when frame end exceeds source size, break out
-            indexBegin = i * nonOverlapped;
-            indexEnd = indexBegin + samplesPerFrame;
-            if (indexEnd <= sourceSize)
-                m_frames.push_back(Frame(source, indexBegin, indexEnd));
-            else
-                break;
+            // only full frames fit in the source
+            const std::size_t indexBegin = i * nonOverlapped;
+            m_frames.push_back(Frame(source, indexBegin,
+                                     indexBegin + samplesPerFrame));
         }
     }
 
@@ -115,5 +110,6 @@ namespace Aquila
     void FramesCollection::clear()
     {
         m_frames.clear();
+        m_views = FrameViews();
     }
 }
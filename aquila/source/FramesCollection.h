@@ -20,10 +20,15 @@
 
 #include "../global.h"
 #include "Frame.h"
+#include "FrameView.h"
 #include <algorithm>
 #include <cstddef>
 #include <functional>
+#include <utility>
 #include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace Aquila
 {
@@ -46,6 +51,11 @@ namespace Aquila
      * Individual frame objects can by accessed by iterating over the collection
      * using begin() and end() methods. These calls simply return iterators
      * pointing to the underlying container.
+     *
+     * The same frames are also available as FrameViews (see views()),
+     * which give direct, contiguous access to frame samples. Code that
+     * only needs the views should use the FrameViews class directly,
+     * which doesn't create any per-frame objects at all.
      */
     class AQUILA_EXPORT FramesCollection
     {
@@ -111,6 +121,18 @@ namespace Aquila
             return m_frames[index];
         }
 
+        /**
+         * Returns views of all frames in the collection.
+         *
+         * The views point to the original source, just like the frames.
+         *
+         * @return frame views
+         */
+        const FrameViews& views() const
+        {
+            return m_views;
+        }
+
         /**
          * Returns an iterator pointing to the first frame.
          *
@@ -166,12 +188,69 @@ namespace Aquila
             return results;
         }
 
+        /**
+         * Applies the calculation f to all frames in the collection.
+         *
+         * This overload is chosen for functions, lambdas and other
+         * function objects callable with a frame. They are called
+         * directly, without wrapping in std::function.
+         *
+         * @param f a function object whose single argument is a SignalSource
+         * @return vector of return values of f - one for each frame
+         */
+        template <typename ResultType, typename Function>
+        auto apply(Function f) const ->
+            decltype(f(std::declval<const Frame&>()), std::vector<ResultType>())
+        {
+            std::vector<ResultType> results(m_frames.size());
+            std::transform(begin(), end(), results.begin(), f);
+            return results;
+        }
+
+        /**
+         * Applies the calculation f to all frames in parallel.
+         *
+         * Frames are distributed among OpenMP threads; each result is
+         * stored at its frame's index, so the order of results is the
+         * same as with apply(). The function must be safe to call from
+         * many threads at once.
+         *
+         * @param f a function object whose single argument is a SignalSource
+         * @param threads number of threads to use, 0 means OpenMP default
+         * @return vector of return values of f - one for each frame
+         */
+        template <typename ResultType, typename Function>
+        std::vector<ResultType> parallelApply(Function f,
+                                              unsigned int threads = 0) const
+        {
+#ifdef _OPENMP
+            const int threadCount = threads > 0 ? static_cast<int>(threads)
+                                                : omp_get_max_threads();
+#else
+            const int threadCount = 1;
+            (void) threads;
+#endif
+            std::vector<ResultType> results(m_frames.size());
+            const long count = static_cast<long>(m_frames.size());
+            #pragma omp parallel for num_threads(threadCount) if(threadCount > 1 && count > 1) schedule(dynamic, 16)
+            for (long i = 0; i < count; ++i)
+            {
+                results[i] = f(m_frames[i]);
+            }
+            return results;
+        }
+
     private:
         /**
          * Frames container.
          */
         Container m_frames;
 
+        /**
+         * Layout of the frames in the source.
+         */
+        FrameViews m_views;
+
         /**
          * Number of samples in each frame.
          */
@@ -0,0 +1,309 @@
+/**
+ * @file MappedWaveFile.cpp
+ *
+ * Memory-mapped, lazily decoded .wav file.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#include "MappedWaveFile.h"
+#include "../Exceptions.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Aquila
+{
+    namespace
+    {
+        /**
+         * Reads a little-endian 32-bit value.
+         *
+         * @param bytes pointer to the first byte
+         * @return the value
+         */
+        std::uint32_t readUint32(const unsigned char* bytes)
+        {
+            return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) |
+                (static_cast<std::uint32_t>(bytes[3]) << 24);
+        }
+    }
+
+    /**
+     * Maps the file into memory and parses its header.
+     *
+     * @param filename full path to .wav file
+     * @throw Aquila::Exception if the file cannot be opened or mapped
+     * @throw Aquila::FormatException if this is not a supported .wav file
+     */
+    MappedWaveFile::MappedWaveFile(const std::string& filename):
+        m_filename(filename), m_header(), m_encoding(PcmDecoder::Int16),
+        m_mapping(nullptr), m_mappingSize(0), m_data(nullptr), m_dataSize(0)
+#ifdef _WIN32
+        , m_file(INVALID_HANDLE_VALUE), m_fileMapping(nullptr)
+#endif
+    {
+        map();
+        try
+        {
+            parseHeader();
+        }
+        catch (...)
+        {
+            unmap();
+            throw;
+        }
+    }
+
+    /**
+     * Unmaps the file.
+     */
+    MappedWaveFile::~MappedWaveFile()
+    {
+        unmap();
+    }
+
+    /**
+     * Decodes a range of frames of one channel.
+     *
+     * @param firstFrame number of the first frame to decode
+     * @param frameCount number of frames to decode
+     * @param channel channel number (0 is left in stereo recordings)
+     * @param output room for frameCount samples
+     * @throw Aquila::Exception if the channel or range is out of bounds
+     */
+    void MappedWaveFile::decode(std::size_t firstFrame, std::size_t frameCount,
+                                unsigned int channel, SampleType output[]) const
+    {
+        if (channel >= m_header.Channels)
+        {
+            throw Exception("Channel number out of range");
+        }
+        if (firstFrame > getFramesCount() ||
+            frameCount > getFramesCount() - firstFrame)
+        {
+            throw Exception("Frame range out of bounds");
+        }
+
+        PcmDecoder::decode(m_encoding, m_data + firstFrame * m_header.BytesPerSamp,
+                           frameCount, m_header.Channels, channel, output);
+    }
+
+    /**
+     * Decodes a range of frames of one channel.
+     *
+     * @param firstFrame number of the first frame to decode
+     * @param frameCount number of frames to decode
+     * @param channel channel number (0 is left in stereo recordings)
+     * @return vector of frameCount samples
+     * @throw Aquila::Exception if the channel or range is out of bounds
+     */
+    std::vector<SampleType> MappedWaveFile::decode(std::size_t firstFrame,
+                                                   std::size_t frameCount,
+                                                   unsigned int channel) const
+    {
+        std::vector<SampleType> output(frameCount);
+        decode(firstFrame, frameCount, channel, output.data());
+        return output;
+    }
+
+    /**
+     * Decodes a range of frames of several channels at once.
+     *
+     * @param firstFrame number of the first frame to decode
+     * @param frameCount number of frames to decode
+     * @param outputs getChannelsNum() pointers, each to room for frameCount
+     *                samples of the corresponding channel, or null to skip
+     *                that channel
+     * @throw Aquila::Exception if the range is out of bounds
+     */
+    void MappedWaveFile::decodeChannels(std::size_t firstFrame,
+                                        std::size_t frameCount,
+                                        SampleType* const outputs[]) const
+    {
+        if (firstFrame > getFramesCount() ||
+            frameCount > getFramesCount() - firstFrame)
+        {
+            throw Exception("Frame range out of bounds");
+        }
+
+        PcmDecoder::deinterleave(m_encoding,
+                                 m_data + firstFrame * m_header.BytesPerSamp,
+                                 frameCount, m_header.Channels, outputs);
+    }
+
+    /**
+     * Returns raw 16-bit samples, interleaved as in the file.
+     *
+     * There are getFramesCount() * getChannelsNum() values.
+     *
+     * @return pointer to the first sample
+     * @throw Aquila::FormatException if this is not a 16-bit file
+     */
+    const std::int16_t* MappedWaveFile::getInt16Data() const
+    {
+        if (PcmDecoder::Int16 != m_encoding)
+        {
+            throw FormatException("Not a 16-bit .wav file");
+        }
+        return reinterpret_cast<const std::int16_t*>(m_data);
+    }
+
+    /**
+     * Maps the whole file read-only.
+     */
+    void MappedWaveFile::map()
+    {
+#ifdef _WIN32
+        m_file = CreateFileA(m_filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                             nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                             nullptr);
+        if (INVALID_HANDLE_VALUE == m_file)
+        {
+            throw Exception("Cannot open file: " + m_filename);
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_file, &size) || 0 == size.QuadPart)
+        {
+            unmap();
+            throw FormatException("Not a RIFF file: " + m_filename);
+        }
+        m_mappingSize = static_cast<std::size_t>(size.QuadPart);
+        m_fileMapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY,
+                                           0, 0, nullptr);
+        if (m_fileMapping)
+        {
+            m_mapping = static_cast<const unsigned char*>(
+                MapViewOfFile(m_fileMapping, FILE_MAP_READ, 0, 0, 0));
+        }
+        if (!m_mapping)
+        {
+            unmap();
+            throw Exception("Cannot map file: " + m_filename);
+        }
+#else
+        const int fd = ::open(m_filename.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw Exception("Cannot open file: " + m_filename);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || 0 == st.st_size)
+        {
+            ::close(fd);
+            throw FormatException("Not a RIFF file: " + m_filename);
+        }
+        m_mappingSize = static_cast<std::size_t>(st.st_size);
+        void* mapping = ::mmap(nullptr, m_mappingSize, PROT_READ, MAP_SHARED,
+                               fd, 0);
+        // the mapping stays valid after closing the descriptor
+        ::close(fd);
+        if (MAP_FAILED == mapping)
+        {
+            throw Exception("Cannot map file: " + m_filename);
+        }
+        ::madvise(mapping, m_mappingSize, MADV_SEQUENTIAL);
+        m_mapping = static_cast<const unsigned char*>(mapping);
+#endif
+    }
+
+    /**
+     * Releases the mapping.
+     */
+    void MappedWaveFile::unmap()
+    {
+#ifdef _WIN32
+        if (m_mapping)
+        {
+            UnmapViewOfFile(m_mapping);
+        }
+        if (m_fileMapping)
+        {
+            CloseHandle(m_fileMapping);
+        }
+        if (INVALID_HANDLE_VALUE != m_file)
+        {
+            CloseHandle(m_file);
+        }
+        m_fileMapping = nullptr;
+        m_file = INVALID_HANDLE_VALUE;
+#else
+        if (m_mapping)
+        {
+            ::munmap(const_cast<unsigned char*>(m_mapping), m_mappingSize);
+        }
+#endif
+        m_mapping = nullptr;
+        m_data = nullptr;
+    }
+
+    /**
+     * Finds format and data chunks, filling the header structure.
+     *
+     * Chunks are visited by their sizes, so other chunks are skipped
+     * without being read. A data chunk which claims to extend past the
+     * end of file (as in interrupted recordings) is truncated.
+     */
+    void MappedWaveFile::parseHeader()
+    {
+        const unsigned char* p = m_mapping;
+        const std::size_t size = m_mappingSize;
+        if (size < 12 || std::memcmp(p, "RIFF", 4) != 0 ||
+            std::memcmp(p + 8, "WAVE", 4) != 0)
+        {
+            throw FormatException("Not a RIFF file: " + m_filename);
+        }
+        std::memcpy(m_header.RIFF, p, 4);
+        m_header.DataLength = readUint32(p + 4);
+        std::memcpy(m_header.WAVE, p + 8, 4);
+
+        bool formatFound = false;
+        std::size_t position = 12;
+        while (position + 8 <= size)
+        {
+            const unsigned char* chunk = p + position;
+            const std::size_t chunkSize = readUint32(chunk + 4);
+            const std::size_t bodySize = std::min(chunkSize, size - position - 8);
+            if (std::memcmp(chunk, "fmt ", 4) == 0 && bodySize >= 16)
+            {
+                std::memcpy(m_header.fmt_, chunk, 4);
+                m_header.SubBlockLength = static_cast<std::uint32_t>(chunkSize);
+                PcmDecoder::readFormatChunk(chunk + 8, bodySize, m_header);
+                formatFound = true;
+            }
+            else if (std::memcmp(chunk, "data", 4) == 0)
+            {
+                std::memcpy(m_header.data, chunk, 4);
+                m_header.WaveSize = static_cast<std::uint32_t>(bodySize);
+                m_data = chunk + 8;
+                m_dataSize = bodySize;
+                break;
+            }
+            // chunks are padded to an even size
+            position += 8 + chunkSize + (chunkSize & 1);
+        }
+
+        if (!formatFound || !m_data)
+        {
+            throw FormatException("Missing fmt or data chunk: " + m_filename);
+        }
+        m_encoding = PcmDecoder::getEncoding(m_header);
+    }
+}
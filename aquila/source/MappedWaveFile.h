@@ -0,0 +1,192 @@
+/**
+ * @file MappedWaveFile.h
+ *
+ * Memory-mapped, lazily decoded .wav file.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#ifndef MAPPEDWAVEFILE_H
+#define MAPPEDWAVEFILE_H
+
+#include "../global.h"
+#include "PcmDecoder.h"
+#include "WaveHeader.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Aquila
+{
+    /**
+     * Read-only access to a .wav file mapped into memory.
+     *
+     * Unlike WaveFile, nothing is read or decoded up front. The file is
+     * mapped into the address space and the PCM data are exposed in
+     * place; the operating system pages them in as they are accessed.
+     * Opening a file of any size is therefore cheap and takes no memory
+     * beyond the mapping itself.
+     *
+     * Samples are decoded on demand, a range of frames at a time, with
+     * decode(). A frame is one sample of every channel; frame numbers
+     * are the same as sample numbers in each channel. Several channels
+     * can also be decoded together, in one pass over the data, with
+     * decodeChannels(). 16-bit files can also be read directly as raw,
+     * interleaved int16 values.
+     *
+     * All formats handled by PcmDecoder are supported, with any number
+     * of channels. Sample values are the same as those read by WaveFile.
+     *
+     * Objects are immutable after construction, so one mapped file can
+     * be decoded by many threads at once.
+     */
+    class AQUILA_EXPORT MappedWaveFile
+    {
+    public:
+        explicit MappedWaveFile(const std::string& filename);
+        MappedWaveFile(const MappedWaveFile&) = delete;
+        MappedWaveFile& operator=(const MappedWaveFile&) = delete;
+        ~MappedWaveFile();
+
+        void decode(std::size_t firstFrame, std::size_t frameCount,
+                    unsigned int channel, SampleType output[]) const;
+        std::vector<SampleType> decode(std::size_t firstFrame,
+                                       std::size_t frameCount,
+                                       unsigned int channel = 0) const;
+        void decodeChannels(std::size_t firstFrame, std::size_t frameCount,
+                            SampleType* const outputs[]) const;
+        const std::int16_t* getInt16Data() const;
+
+        /**
+         * Returns the filename.
+         *
+         * @return full path to the mapped file
+         */
+        std::string getFilename() const
+        {
+            return m_filename;
+        }
+
+        /**
+         * Returns the parsed header.
+         *
+         * @return header structure
+         */
+        const WaveHeader& getHeader() const
+        {
+            return m_header;
+        }
+
+        /**
+         * Returns number of channels.
+         *
+         * @return channel count
+         */
+        unsigned short getChannelsNum() const
+        {
+            return m_header.Channels;
+        }
+
+        /**
+         * Returns sample frequency.
+         *
+         * @return sample frequency in Hz
+         */
+        FrequencyType getSampleFrequency() const
+        {
+            return m_header.SampFreq;
+        }
+
+        /**
+         * Returns number of bits per sample.
+         *
+         * @return sample size in bits
+         */
+        unsigned short getBitsPerSample() const
+        {
+            return m_header.BitsPerSamp;
+        }
+
+        /**
+         * Returns number of frames, i.e. samples in each channel.
+         *
+         * @return frame count
+         */
+        std::size_t getFramesCount() const
+        {
+            return m_dataSize / m_header.BytesPerSamp;
+        }
+
+        /**
+         * Returns the PCM data as stored in the file.
+         *
+         * @return pointer to the first byte of the data chunk
+         */
+        const unsigned char* getData() const
+        {
+            return m_data;
+        }
+
+        /**
+         * Returns the size of PCM data.
+         *
+         * @return byte count
+         */
+        std::size_t getDataSize() const
+        {
+            return m_dataSize;
+        }
+
+    private:
+        void map();
+        void unmap();
+        void parseHeader();
+
+        /**
+         * Full path of the .wav file.
+         */
+        const std::string m_filename;
+
+        /**
+         * Header structure.
+         */
+        WaveHeader m_header;
+
+        /**
+         * Sample encoding.
+         */
+        PcmDecoder::Encoding m_encoding;
+
+        /**
+         * Beginning and size of the whole mapping.
+         */
+        const unsigned char* m_mapping;
+        std::size_t m_mappingSize;
+
+        /**
+         * Beginning and size of the data chunk (within the mapping).
+         */
+        const unsigned char* m_data;
+        std::size_t m_dataSize;
+
+#ifdef _WIN32
+        /**
+         * File and mapping handles.
+         */
+        void* m_file;
+        void* m_fileMapping;
+#endif
+    };
+}
+
+#endif // MAPPEDWAVEFILE_H
@@ -0,0 +1,716 @@
+/**
+ * @file PcmDecoder.cpp
+ *
+ * Conversion of .wav sample data to floating-point samples.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#include "PcmDecoder.h"
+#include "PcmKernels.h"
+#include "../Exceptions.h"
+#include "../simd.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace Aquila
+{
+    const std::uint16_t PcmDecoder::FORMAT_PCM;
+    const std::uint16_t PcmDecoder::FORMAT_IEEE_FLOAT;
+    const std::uint16_t PcmDecoder::FORMAT_EXTENSIBLE;
+
+    namespace
+    {
+        /**
+         * Last 14 bytes of KSDATAFORMAT_SUBTYPE_* GUIDs; the first two
+         * are the format tag.
+         */
+        const unsigned char SUBFORMAT_GUID_TAIL[14] = {
+            0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00,
+            0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71
+        };
+
+        std::uint16_t readUint16(const unsigned char* bytes)
+        {
+            return static_cast<std::uint16_t>(bytes[0] | (bytes[1] << 8));
+        }
+
+        std::uint32_t readUint32(const unsigned char* bytes)
+        {
+            return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) |
+                (static_cast<std::uint32_t>(bytes[3]) << 24);
+        }
+
+        /**
+         * Sample readers, one for each encoding.
+         *
+         * Little-endian byte order of the host is assumed, as in the
+         * rest of .wav file handling.
+         */
+        struct UInt8Reader
+        {
+            static SampleType read(const unsigned char* p)
+            {
+                return static_cast<SampleType>(static_cast<int>(*p) - 128);
+            }
+        };
+
+        struct Int16Reader
+        {
+            static SampleType read(const unsigned char* p)
+            {
+                std::int16_t value;
+                std::memcpy(&value, p, sizeof(value));
+                return value;
+            }
+        };
+
+        struct Int24Reader
+        {
+            static SampleType read(const unsigned char* p)
+            {
+                // shift the value to the top of 32 bits and back,
+                // extending its sign
+                const std::uint32_t bits = (p[0] << 8) | (p[1] << 16) |
+                    (static_cast<std::uint32_t>(p[2]) << 24);
+                return static_cast<SampleType>(static_cast<std::int32_t>(bits) >> 8);
+            }
+        };
+
+        struct Int32Reader
+        {
+            static SampleType read(const unsigned char* p)
+            {
+                std::int32_t value;
+                std::memcpy(&value, p, sizeof(value));
+                return static_cast<SampleType>(value);
+            }
+        };
+
+        struct Float32Reader
+        {
+            static SampleType read(const unsigned char* p)
+            {
+                float value;
+                std::memcpy(&value, p, sizeof(value));
+                return value;
+            }
+        };
+
+        struct Float64Reader
+        {
+            static SampleType read(const unsigned char* p)
+            {
+                double value;
+                std::memcpy(&value, p, sizeof(value));
+                return static_cast<SampleType>(value);
+            }
+        };
+
+        /**
+         * Decodes every stride-th sample, starting at data.
+         */
+        template <typename Reader>
+        void decodeStrided(const unsigned char* data, std::size_t stride,
+                           std::size_t count, SampleType output[])
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                output[i] = Reader::read(data + i * stride);
+            }
+        }
+
+        /**
+         * Decodes the selected channels of every frame, one frame at a time.
+         */
+        template <typename Reader>
+        void decodePlanar(const unsigned char* data, std::size_t sampleSize,
+                          std::size_t frameCount, unsigned int channels,
+                          const std::vector<unsigned int>& selected,
+                          SampleType* const outputs[], std::size_t first)
+        {
+            const std::size_t stride = channels * sampleSize;
+            for (std::size_t i = 0; i < frameCount; ++i)
+            {
+                const unsigned char* frame = data + i * stride;
+                for (unsigned int channel : selected)
+                {
+                    outputs[channel][first + i] =
+                        Reader::read(frame + channel * sampleSize);
+                }
+            }
+        }
+
+        /**
+         * Stores four 32-bit integers as samples.
+         */
+#if defined(AQUILA_HAVE_SSE2)
+        inline void store4(SampleType* output, __m128i values)
+        {
+#ifdef AQUILA_USE_FLOAT
+            _mm_storeu_ps(output, _mm_cvtepi32_ps(values));
+#else
+            _mm_storeu_pd(output, _mm_cvtepi32_pd(values));
+            _mm_storeu_pd(output + 2, _mm_cvtepi32_pd(_mm_srli_si128(values, 8)));
+#endif
+        }
+#elif defined(AQUILA_HAVE_NEON)
+        inline void store4(SampleType* output, int32x4_t values)
+        {
+#ifdef AQUILA_USE_FLOAT
+            vst1q_f32(output, vcvtq_f32_s32(values));
+#else
+            vst1q_f64(output, vcvtq_f64_s64(vmovl_s32(vget_low_s32(values))));
+            vst1q_f64(output + 2, vcvtq_f64_s64(vmovl_s32(vget_high_s32(values))));
+#endif
+        }
+
+        /**
+         * Widens eight unsigned 8-bit samples, moving them by 128.
+         */
+        inline int16x8_t widenUInt8(uint8x8_t values)
+        {
+            return vreinterpretq_s16_u16(
+                vsubq_u16(vmovl_u8(values), vdupq_n_u16(128)));
+        }
+#endif
+
+        /**
+         * Converts contiguous 16-bit samples.
+         */
+        void convertInt16(const unsigned char* data, std::size_t count,
+                          SampleType output[])
+        {
+            std::size_t i = 0;
+#if defined(AQUILA_HAVE_SSE2)
+            for (; i + 8 <= count; i += 8)
+            {
+                __m128i v = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(data + 2 * i));
+                // sign-extend to 32 bits by interleaving with itself
+                // and shifting arithmetically
+                store4(output + i, _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+                store4(output + i + 4, _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+            }
+#elif defined(AQUILA_HAVE_NEON)
+            for (; i + 8 <= count; i += 8)
+            {
+                int16x8_t v = vld1q_s16(reinterpret_cast<const std::int16_t*>(data + 2 * i));
+                store4(output + i, vmovl_s16(vget_low_s16(v)));
+                store4(output + i + 4, vmovl_s16(vget_high_s16(v)));
+            }
+#endif
+            convertInt16Scalar(data + 2 * i, count - i, output + i);
+        }
+
+        /**
+         * Converts contiguous unsigned 8-bit samples.
+         */
+        void convertUInt8(const unsigned char* data, std::size_t count,
+                          SampleType output[])
+        {
+            std::size_t i = 0;
+#if defined(AQUILA_HAVE_SSE2)
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i offset = _mm_set1_epi32(128);
+            for (; i + 16 <= count; i += 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                __m128i lo = _mm_unpacklo_epi8(v, zero);
+                __m128i hi = _mm_unpackhi_epi8(v, zero);
+                store4(output + i, _mm_sub_epi32(_mm_unpacklo_epi16(lo, zero), offset));
+                store4(output + i + 4, _mm_sub_epi32(_mm_unpackhi_epi16(lo, zero), offset));
+                store4(output + i + 8, _mm_sub_epi32(_mm_unpacklo_epi16(hi, zero), offset));
+                store4(output + i + 12, _mm_sub_epi32(_mm_unpackhi_epi16(hi, zero), offset));
+            }
+#elif defined(AQUILA_HAVE_NEON)
+            for (; i + 8 <= count; i += 8)
+            {
+                int16x8_t v = widenUInt8(vld1_u8(data + i));
+                store4(output + i, vmovl_s16(vget_low_s16(v)));
+                store4(output + i + 4, vmovl_s16(vget_high_s16(v)));
+            }
+#endif
+            convertUInt8Scalar(data + i, count - i, output + i);
+        }
+
+        /**
+         * Splits 16-bit stereo frames into two channels.
+         */
+        void deinterleaveInt16(const unsigned char* data, std::size_t frameCount,
+                               SampleType* left, SampleType* right)
+        {
+            std::size_t i = 0;
+#if defined(AQUILA_HAVE_SSE2)
+            for (; i + 4 <= frameCount; i += 4)
+            {
+                // a frame is a 32-bit value with the left sample in low half
+                __m128i v = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(data + 4 * i));
+                store4(left + i, _mm_srai_epi32(_mm_slli_epi32(v, 16), 16));
+                store4(right + i, _mm_srai_epi32(v, 16));
+            }
+#elif defined(AQUILA_HAVE_NEON)
+            for (; i + 8 <= frameCount; i += 8)
+            {
+                int16x8x2_t v = vld2q_s16(reinterpret_cast<const std::int16_t*>(data + 4 * i));
+                store4(left + i, vmovl_s16(vget_low_s16(v.val[0])));
+                store4(left + i + 4, vmovl_s16(vget_high_s16(v.val[0])));
+                store4(right + i, vmovl_s16(vget_low_s16(v.val[1])));
+                store4(right + i + 4, vmovl_s16(vget_high_s16(v.val[1])));
+            }
+#endif
+            deinterleaveInt16Scalar(data + 4 * i, frameCount - i, left + i, right + i);
+        }
+
+        /**
+         * Splits unsigned 8-bit stereo frames into two channels.
+         */
+        void deinterleaveUInt8(const unsigned char* data, std::size_t frameCount,
+                               SampleType* left, SampleType* right)
+        {
+            std::size_t i = 0;
+#if defined(AQUILA_HAVE_SSE2)
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i offset = _mm_set1_epi32(128);
+            const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+            for (; i + 8 <= frameCount; i += 8)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 2 * i));
+                __m128i l = _mm_and_si128(v, lowBytes);
+                __m128i r = _mm_srli_epi16(v, 8);
+                store4(left + i, _mm_sub_epi32(_mm_unpacklo_epi16(l, zero), offset));
+                store4(left + i + 4, _mm_sub_epi32(_mm_unpackhi_epi16(l, zero), offset));
+                store4(right + i, _mm_sub_epi32(_mm_unpacklo_epi16(r, zero), offset));
+                store4(right + i + 4, _mm_sub_epi32(_mm_unpackhi_epi16(r, zero), offset));
+            }
+#elif defined(AQUILA_HAVE_NEON)
+            for (; i + 8 <= frameCount; i += 8)
+            {
+                uint8x8x2_t v = vld2_u8(data + 2 * i);
+                int16x8_t l = widenUInt8(v.val[0]);
+                int16x8_t r = widenUInt8(v.val[1]);
+                store4(left + i, vmovl_s16(vget_low_s16(l)));
+                store4(left + i + 4, vmovl_s16(vget_high_s16(l)));
+                store4(right + i, vmovl_s16(vget_low_s16(r)));
+                store4(right + i + 4, vmovl_s16(vget_high_s16(r)));
+            }
+#endif
+            deinterleaveUInt8Scalar(data + 2 * i, frameCount - i, left + i, right + i);
+        }
+
+        /**
+         * Converts contiguous 32-bit integer samples.
+         */
+        void convertInt32(const unsigned char* data, std::size_t count,
+                          SampleType output[])
+        {
+            std::size_t i = 0;
+#if defined(AQUILA_HAVE_SSE2)
+            for (; i + 4 <= count; i += 4)
+            {
+                store4(output + i, _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(data + 4 * i)));
+            }
+#elif defined(AQUILA_HAVE_NEON)
+            for (; i + 4 <= count; i += 4)
+            {
+                store4(output + i, vld1q_s32(reinterpret_cast<const std::int32_t*>(data + 4 * i)));
+            }
+#endif
+            decodeStrided<Int32Reader>(data + 4 * i, 4, count - i, output + i);
+        }
+
+        /**
+         * Converts contiguous 32-bit float samples.
+         */
+        void convertFloat32(const unsigned char* data, std::size_t count,
+                            SampleType output[])
+        {
+            std::size_t i = 0;
+#if defined(AQUILA_USE_FLOAT)
+            std::memcpy(output, data, count * sizeof(float));
+            i = count;
+#elif defined(AQUILA_HAVE_SSE2)
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128 v = _mm_loadu_ps(reinterpret_cast<const float*>(data + 4 * i));
+                _mm_storeu_pd(output + i, _mm_cvtps_pd(v));
+                _mm_storeu_pd(output + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+            }
+#elif defined(AQUILA_HAVE_NEON)
+            for (; i + 4 <= count; i += 4)
+            {
+                float32x4_t v = vld1q_f32(reinterpret_cast<const float*>(data + 4 * i));
+                vst1q_f64(output + i, vcvt_f64_f32(vget_low_f32(v)));
+                vst1q_f64(output + i + 2, vcvt_high_f64_f32(v));
+            }
+#endif
+            decodeStrided<Float32Reader>(data + 4 * i, 4, count - i, output + i);
+        }
+
+        /**
+         * Converts contiguous 64-bit float samples.
+         */
+        void convertFloat64(const unsigned char* data, std::size_t count,
+                            SampleType output[])
+        {
+#ifdef AQUILA_USE_FLOAT
+            decodeStrided<Float64Reader>(data, 8, count, output);
+#else
+            std::memcpy(output, data, count * sizeof(double));
+#endif
+        }
+
+        /**
+         * Kernels for the most common formats, selected for the processor.
+         */
+        struct Kernels
+        {
+            PcmConvertFunction int16;
+            PcmConvertFunction uint8;
+            PcmDeinterleaveFunction int16Stereo;
+            PcmDeinterleaveFunction uint8Stereo;
+            const char* name;
+        };
+
+        Kernels selectKernels()
+        {
+            Kernels kernels = {convertInt16, convertUInt8, deinterleaveInt16,
+                               deinterleaveUInt8,
+#if defined(AQUILA_HAVE_SSE2)
+                               "sse2"
+#elif defined(AQUILA_HAVE_NEON)
+                               "neon"
+#else
+                               "scalar"
+#endif
+            };
+#ifdef AQUILA_HAVE_AVX2
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2"))
+            {
+                kernels.int16 = convertInt16Avx2;
+                kernels.uint8 = convertUInt8Avx2;
+                kernels.int16Stereo = deinterleaveInt16Avx2;
+                kernels.uint8Stereo = deinterleaveUInt8Avx2;
+                kernels.name = "avx2";
+            }
+#endif
+            return kernels;
+        }
+
+        const Kernels& getKernels()
+        {
+            static const Kernels kernels = selectKernels();
+            return kernels;
+        }
+
+        /**
+         * Minimal number of decoded samples worth splitting between threads.
+         *
+         * A single thread converts about a billion 16-bit samples per
+         * second, so this is a few hundred microseconds of work - well
+         * above the cost of starting a thread team. Smaller buffers (such
+         * as the parts read by WaveFileHandler::readPart()) are decoded
+         * by the calling thread alone.
+         */
+        const std::size_t PARALLEL_DECODE_SAMPLES = 1 << 18;
+
+        /**
+         * Number of frames decoded by a thread at a time.
+         */
+        const std::size_t DECODE_BLOCK_FRAMES = 1 << 14;
+
+        /**
+         * Calls decodeBlock(first, count) for consecutive blocks of frames.
+         *
+         * Blocks are split between OpenMP threads only if there are at
+         * least PARALLEL_DECODE_SAMPLES samples to decode.
+         */
+        template <typename Function>
+        void decodeBlocks(std::size_t frameCount, std::size_t samplesPerFrame,
+                          Function decodeBlock)
+        {
+            const long blocks = static_cast<long>(
+                (frameCount + DECODE_BLOCK_FRAMES - 1) / DECODE_BLOCK_FRAMES);
+            #pragma omp parallel for if(frameCount * samplesPerFrame >= PARALLEL_DECODE_SAMPLES)
+            for (long b = 0; b < blocks; ++b)
+            {
+                const std::size_t first = b * DECODE_BLOCK_FRAMES;
+                decodeBlock(first, std::min(DECODE_BLOCK_FRAMES, frameCount - first));
+            }
+        }
+
+        /**
+         * Decodes one channel of a range of frames in the calling thread.
+         */
+        void decodeRange(PcmDecoder::Encoding encoding, const unsigned char* data,
+                         std::size_t frameCount, unsigned int channels,
+                         unsigned int channel, SampleType output[])
+        {
+            const std::size_t sampleSize = PcmDecoder::getSampleSize(encoding);
+            const std::size_t stride = channels * sampleSize;
+            const unsigned char* first = data + channel * sampleSize;
+            const bool contiguous = 1 == channels;
+
+            switch (encoding)
+            {
+            case PcmDecoder::UInt8:
+                if (contiguous)
+                    getKernels().uint8(first, frameCount, output);
+                else
+                    decodeStrided<UInt8Reader>(first, stride, frameCount, output);
+                break;
+            case PcmDecoder::Int16:
+                if (contiguous)
+                    getKernels().int16(first, frameCount, output);
+                else
+                    decodeStrided<Int16Reader>(first, stride, frameCount, output);
+                break;
+            case PcmDecoder::Int24:
+                decodeStrided<Int24Reader>(first, stride, frameCount, output);
+                break;
+            case PcmDecoder::Int32:
+                if (contiguous)
+                    convertInt32(first, frameCount, output);
+                else
+                    decodeStrided<Int32Reader>(first, stride, frameCount, output);
+                break;
+            case PcmDecoder::Float32:
+                if (contiguous)
+                    convertFloat32(first, frameCount, output);
+                else
+                    decodeStrided<Float32Reader>(first, stride, frameCount, output);
+                break;
+            case PcmDecoder::Float64:
+                if (contiguous)
+                    convertFloat64(first, frameCount, output);
+                else
+                    decodeStrided<Float64Reader>(first, stride, frameCount, output);
+                break;
+            }
+        }
+
+        /**
+         * Decodes selected channels of a range of frames in the calling thread.
+         */
+        void deinterleaveRange(PcmDecoder::Encoding encoding,
+                               const unsigned char* data, std::size_t first,
+                               std::size_t frameCount, unsigned int channels,
+                               const std::vector<unsigned int>& selected,
+                               SampleType* const outputs[])
+        {
+            const std::size_t sampleSize = PcmDecoder::getSampleSize(encoding);
+            const unsigned char* frames = data + first * channels * sampleSize;
+            // selected.size() > 1, so stereo means both channels
+            if (2 == channels && PcmDecoder::Int16 == encoding)
+            {
+                getKernels().int16Stereo(frames, frameCount,
+                                         outputs[0] + first, outputs[1] + first);
+                return;
+            }
+            if (2 == channels && PcmDecoder::UInt8 == encoding)
+            {
+                getKernels().uint8Stereo(frames, frameCount,
+                                         outputs[0] + first, outputs[1] + first);
+                return;
+            }
+
+            switch (encoding)
+            {
+            case PcmDecoder::UInt8:
+                decodePlanar<UInt8Reader>(frames, sampleSize, frameCount,
+                                          channels, selected, outputs, first);
+                break;
+            case PcmDecoder::Int16:
+                decodePlanar<Int16Reader>(frames, sampleSize, frameCount,
+                                          channels, selected, outputs, first);
+                break;
+            case PcmDecoder::Int24:
+                decodePlanar<Int24Reader>(frames, sampleSize, frameCount,
+                                          channels, selected, outputs, first);
+                break;
+            case PcmDecoder::Int32:
+                decodePlanar<Int32Reader>(frames, sampleSize, frameCount,
+                                          channels, selected, outputs, first);
+                break;
+            case PcmDecoder::Float32:
+                decodePlanar<Float32Reader>(frames, sampleSize, frameCount,
+                                            channels, selected, outputs, first);
+                break;
+            case PcmDecoder::Float64:
+                decodePlanar<Float64Reader>(frames, sampleSize, frameCount,
+                                            channels, selected, outputs, first);
+                break;
+            }
+        }
+    }
+
+    /**
+     * Reads the body of a fmt chunk into the header.
+     *
+     * For WAVE_FORMAT_EXTENSIBLE files the sub-format GUID is read and
+     * its format code (PCM or IEEE float) is stored as the format tag,
+     * so that these files are handled in the same way as plain ones.
+     * Unknown sub-formats leave the FORMAT_EXTENSIBLE tag unchanged.
+     *
+     * @param body fmt chunk body
+     * @param size fmt chunk body size (at least 16 bytes)
+     * @param header header to fill
+     * @throw Aquila::FormatException if the chunk is too short
+     */
+    void PcmDecoder::readFormatChunk(const unsigned char body[],
+                                     std::size_t size, WaveHeader& header)
+    {
+        if (size < 16)
+        {
+            throw FormatException("Invalid fmt chunk");
+        }
+        header.formatTag = readUint16(body);
+        header.Channels = readUint16(body + 2);
+        header.SampFreq = readUint32(body + 4);
+        header.BytesPerSec = readUint32(body + 8);
+        header.BytesPerSamp = readUint16(body + 12);
+        header.BitsPerSamp = readUint16(body + 14);
+
+        // cbSize, valid bits, channel mask and sub-format GUID
+        if (FORMAT_EXTENSIBLE == header.formatTag && size >= 40 &&
+            std::memcmp(body + 26, SUBFORMAT_GUID_TAIL, 14) == 0)
+        {
+            header.formatTag = readUint16(body + 24);
+        }
+    }
+
+    /**
+     * Determines the sample encoding described by a header.
+     *
+     * @param header .wav header
+     * @return sample encoding
+     * @throw Aquila::FormatException for unsupported formats
+     */
+    PcmDecoder::Encoding PcmDecoder::getEncoding(const WaveHeader& header)
+    {
+        if (0 == header.Channels ||
+            header.BytesPerSamp != header.Channels * (header.BitsPerSamp / 8))
+        {
+            throw FormatException("Invalid .wav block alignment");
+        }
+        if (FORMAT_PCM == header.formatTag)
+        {
+            switch (header.BitsPerSamp)
+            {
+            case 8:
+                return UInt8;
+            case 16:
+                return Int16;
+            case 24:
+                return Int24;
+            case 32:
+                return Int32;
+            }
+        }
+        else if (FORMAT_IEEE_FLOAT == header.formatTag)
+        {
+            if (32 == header.BitsPerSamp)
+                return Float32;
+            if (64 == header.BitsPerSamp)
+                return Float64;
+        }
+        throw FormatException("Unsupported .wav sample format");
+    }
+
+    /**
+     * Returns the size of a single sample.
+     *
+     * @param encoding sample encoding
+     * @return size in bytes
+     */
+    std::size_t PcmDecoder::getSampleSize(Encoding encoding)
+    {
+        static const std::size_t sizes[] = {1, 2, 3, 4, 4, 8};
+        return sizes[encoding];
+    }
+
+    /**
+     * Returns the name of instruction set used by int16 and uint8 kernels.
+     *
+     * @return "avx2", "sse2", "neon" or "scalar"
+     */
+    const char* PcmDecoder::getKernelName()
+    {
+        return getKernels().name;
+    }
+
+    /**
+     * Decodes one channel of interleaved sample data.
+     *
+     * @param encoding sample encoding
+     * @param data interleaved samples of all channels
+     * @param frameCount number of samples in each channel
+     * @param channels number of channels
+     * @param channel which channel to decode
+     * @param output room for frameCount samples
+     */
+    void PcmDecoder::decode(Encoding encoding, const unsigned char data[],
+                            std::size_t frameCount, unsigned int channels,
+                            unsigned int channel, SampleType output[])
+    {
+        const std::size_t frameSize = channels * getSampleSize(encoding);
+        decodeBlocks(frameCount, 1, [&](std::size_t first, std::size_t count)
+        {
+            decodeRange(encoding, data + first * frameSize, count, channels,
+                        channel, output + first);
+        });
+    }
+
+    /**
+     * Decodes selected channels of interleaved sample data in one pass.
+     *
+     * Each output receives the samples of one channel. Channels with
+     * a null output are skipped and not decoded at all.
+     *
+     * @param encoding sample encoding
+     * @param data interleaved samples of all channels
+     * @param frameCount number of samples in each channel
+     * @param channels number of channels
+     * @param outputs one pointer per channel, to room for frameCount
+     *                samples or null
+     */
+    void PcmDecoder::deinterleave(Encoding encoding, const unsigned char data[],
+                                  std::size_t frameCount, unsigned int channels,
+                                  SampleType* const outputs[])
+    {
+        std::vector<unsigned int> selected;
+        for (unsigned int channel = 0; channel < channels; ++channel)
+        {
+            if (outputs[channel])
+                selected.push_back(channel);
+        }
+        if (selected.empty())
+            return;
+        if (1 == selected.size())
+        {
+            decode(encoding, data, frameCount, channels, selected[0],
+                   outputs[selected[0]]);
+            return;
+        }
+
+        decodeBlocks(frameCount, selected.size(),
+                     [&](std::size_t first, std::size_t count)
+        {
+            deinterleaveRange(encoding, data, first, count, channels,
+                              selected, outputs);
+        });
+    }
+}
@@ -0,0 +1,76 @@
+/**
+ * @file PcmDecoder.h
+ *
+ * Conversion of .wav sample data to floating-point samples.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#ifndef PCMDECODER_H
+#define PCMDECODER_H
+
+#include "../global.h"
+#include "WaveHeader.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Aquila
+{
+    /**
+     * Decodes interleaved .wav sample data of all common encodings.
+     *
+     * Supported encodings are 8-bit unsigned, 16-bit, 24-bit (packed in
+     * 3 bytes) and 32-bit signed integer PCM, and 32-bit and 64-bit IEEE
+     * float, in plain and WAVE_FORMAT_EXTENSIBLE files.
+     *
+     * Decoded values are not rescaled: integers keep their range (8-bit
+     * samples are moved by 128, so that silence is zero), and floats
+     * their usual -1.0 to 1.0 range.
+     *
+     * Channels are decoded one at a time with decode(), or all selected
+     * channels at once into separate (planar) buffers with deinterleave().
+     * The most common cases - 8-bit and 16-bit mono and stereo data - are
+     * converted by vector kernels (AVX2, chosen at runtime if the processor
+     * supports it, otherwise SSE2 or NEON). Large buffers are also split
+     * between OpenMP threads.
+     */
+    class AQUILA_EXPORT PcmDecoder
+    {
+    public:
+        /**
+         * Sample encodings.
+         */
+        enum Encoding {UInt8, Int16, Int24, Int32, Float32, Float64};
+
+        /**
+         * Format tags of the fmt chunk.
+         */
+        static const std::uint16_t FORMAT_PCM = 0x0001;
+        static const std::uint16_t FORMAT_IEEE_FLOAT = 0x0003;
+        static const std::uint16_t FORMAT_EXTENSIBLE = 0xFFFE;
+
+        static void readFormatChunk(const unsigned char body[],
+                                    std::size_t size, WaveHeader& header);
+        static Encoding getEncoding(const WaveHeader& header);
+        static std::size_t getSampleSize(Encoding encoding);
+        static const char* getKernelName();
+
+        static void decode(Encoding encoding, const unsigned char data[],
+                           std::size_t frameCount, unsigned int channels,
+                           unsigned int channel, SampleType output[]);
+        static void deinterleave(Encoding encoding, const unsigned char data[],
+                                 std::size_t frameCount, unsigned int channels,
+                                 SampleType* const outputs[]);
+    };
+}
+
+#endif // PCMDECODER_H
@@ -0,0 +1,139 @@
+/**
+ * @file PcmDecoderAvx2.cpp
+ *
+ * AVX2 code path of PcmDecoder sample conversion.
+ *
+ * This file is compiled with AVX2 instructions enabled, but its code is
+ * called only after a runtime check that the processor supports them.
+ * Therefore it must not define anything else than the kernels themselves.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#include "PcmKernels.h"
+#include <immintrin.h>
+
+namespace Aquila
+{
+    namespace
+    {
+        /**
+         * Stores eight 32-bit integers as samples.
+         */
+        inline void store8(SampleType* output, __m256i values)
+        {
+#ifdef AQUILA_USE_FLOAT
+            _mm256_storeu_ps(output, _mm256_cvtepi32_ps(values));
+#else
+            _mm256_storeu_pd(output,
+                _mm256_cvtepi32_pd(_mm256_castsi256_si128(values)));
+            _mm256_storeu_pd(output + 4,
+                _mm256_cvtepi32_pd(_mm256_extracti128_si256(values, 1)));
+#endif
+        }
+    }
+
+    /**
+     * Converts 16-bit samples, 16 at a time.
+     *
+     * @param data samples
+     * @param count number of samples
+     * @param output room for count samples
+     */
+    void convertInt16Avx2(const unsigned char* data, std::size_t count,
+                          SampleType* output)
+    {
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i lo = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(data + 2 * i));
+            __m128i hi = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(data + 2 * i + 16));
+            store8(output + i, _mm256_cvtepi16_epi32(lo));
+            store8(output + i + 8, _mm256_cvtepi16_epi32(hi));
+        }
+        convertInt16Scalar(data + 2 * i, count - i, output + i);
+    }
+
+    /**
+     * Converts unsigned 8-bit samples, 16 at a time.
+     *
+     * @param data samples
+     * @param count number of samples
+     * @param output room for count samples
+     */
+    void convertUInt8Avx2(const unsigned char* data, std::size_t count,
+                          SampleType* output)
+    {
+        const __m256i offset = _mm256_set1_epi32(128);
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            store8(output + i, _mm256_sub_epi32(_mm256_cvtepu8_epi32(v), offset));
+            store8(output + i + 8, _mm256_sub_epi32(
+                _mm256_cvtepu8_epi32(_mm_srli_si128(v, 8)), offset));
+        }
+        convertUInt8Scalar(data + i, count - i, output + i);
+    }
+
+    /**
+     * Splits 16-bit stereo frames, 8 at a time.
+     *
+     * Each frame is loaded as a single 32-bit value, with the left sample
+     * in its low half; both halves are sign-extended by shifting.
+     *
+     * @param data interleaved samples
+     * @param frameCount number of frames
+     * @param left room for frameCount samples of the left channel
+     * @param right room for frameCount samples of the right channel
+     */
+    void deinterleaveInt16Avx2(const unsigned char* data, std::size_t frameCount,
+                               SampleType* left, SampleType* right)
+    {
+        std::size_t i = 0;
+        for (; i + 8 <= frameCount; i += 8)
+        {
+            __m256i v = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(data + 4 * i));
+            store8(left + i, _mm256_srai_epi32(_mm256_slli_epi32(v, 16), 16));
+            store8(right + i, _mm256_srai_epi32(v, 16));
+        }
+        deinterleaveInt16Scalar(data + 4 * i, frameCount - i, left + i, right + i);
+    }
+
+    /**
+     * Splits unsigned 8-bit stereo frames, 8 at a time.
+     *
+     * @param data interleaved samples
+     * @param frameCount number of frames
+     * @param left room for frameCount samples of the left channel
+     * @param right room for frameCount samples of the right channel
+     */
+    void deinterleaveUInt8Avx2(const unsigned char* data, std::size_t frameCount,
+                               SampleType* left, SampleType* right)
+    {
+        const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+        const __m256i offset = _mm256_set1_epi32(128);
+        std::size_t i = 0;
+        for (; i + 8 <= frameCount; i += 8)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 2 * i));
+            __m128i l = _mm_and_si128(v, lowBytes);
+            __m128i r = _mm_srli_epi16(v, 8);
+            store8(left + i, _mm256_sub_epi32(_mm256_cvtepu16_epi32(l), offset));
+            store8(right + i, _mm256_sub_epi32(_mm256_cvtepu16_epi32(r), offset));
+        }
+        deinterleaveUInt8Scalar(data + 2 * i, frameCount - i, left + i, right + i);
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ * @file PcmKernels.h
+ *
+ * Sample conversion kernels shared by PcmDecoder code paths.
+ *
+ * This is an internal header, used only by PcmDecoder implementation files.
+ * Kernels compiled for instruction sets which may be missing at runtime
+ * (AVX2) live in separate files and are selected by PcmDecoder after
+ * checking the processor.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#ifndef PCMKERNELS_H
+#define PCMKERNELS_H
+
+#include "../global.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Aquila
+{
+    /**
+     * Converts count contiguous samples of one channel.
+     */
+    typedef void (*PcmConvertFunction)(const unsigned char* data,
+                                       std::size_t count, SampleType* output);
+
+    /**
+     * Splits frameCount interleaved stereo frames into two channels.
+     */
+    typedef void (*PcmDeinterleaveFunction)(const unsigned char* data,
+                                            std::size_t frameCount,
+                                            SampleType* left,
+                                            SampleType* right);
+
+    /**
+     * Scalar kernels, also used for the tails of vector loops.
+     *
+     * They are declared in an anonymous namespace, so that copies compiled
+     * for different instruction sets never get merged by the linker.
+     */
+    namespace
+    {
+        inline void convertInt16Scalar(const unsigned char* data, std::size_t count,
+                                       SampleType* output)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                std::int16_t value;
+                std::memcpy(&value, data + 2 * i, sizeof(value));
+                output[i] = value;
+            }
+        }
+
+        inline void convertUInt8Scalar(const unsigned char* data, std::size_t count,
+                                       SampleType* output)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                output[i] = static_cast<int>(data[i]) - 128;
+            }
+        }
+
+        inline void deinterleaveInt16Scalar(const unsigned char* data,
+                                            std::size_t frameCount,
+                                            SampleType* left, SampleType* right)
+        {
+            for (std::size_t i = 0; i < frameCount; ++i)
+            {
+                std::int16_t values[2];
+                std::memcpy(values, data + 4 * i, sizeof(values));
+                left[i] = values[0];
+                right[i] = values[1];
+            }
+        }
+
+        inline void deinterleaveUInt8Scalar(const unsigned char* data,
+                                            std::size_t frameCount,
+                                            SampleType* left, SampleType* right)
+        {
+            for (std::size_t i = 0; i < frameCount; ++i)
+            {
+                left[i] = static_cast<int>(data[2 * i]) - 128;
+                right[i] = static_cast<int>(data[2 * i + 1]) - 128;
+            }
+        }
+    }
+
+    /**
+     * AVX2 kernels, defined only when compiled with AQUILA_HAVE_AVX2.
+     */
+    void convertInt16Avx2(const unsigned char* data, std::size_t count,
+                          SampleType* output);
+    void convertUInt8Avx2(const unsigned char* data, std::size_t count,
+                          SampleType* output);
+    void deinterleaveInt16Avx2(const unsigned char* data, std::size_t frameCount,
+                               SampleType* left, SampleType* right);
+    void deinterleaveUInt8Avx2(const unsigned char* data, std::size_t frameCount,
+                               SampleType* left, SampleType* right);
+}
+
+#endif // PCMKERNELS_H
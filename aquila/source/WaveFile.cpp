@@ -28,7 +28,7 @@ namespace Aquila
     WaveFile::WaveFile(const std::string& filename, StereoChannel channel):
         SignalSource(), m_filename(filename), m_channel(channel), m_partSize(0), m_handler(filename)
     {
-        m_handler.readHeader(m_header);
+        load(m_filename, m_channel);
     }
 
     WaveFile::WaveFile(const std::string& filename, size_t part_size, StereoChannel channel):
@@ -69,35 +69,26 @@ namespace Aquila
     {
         m_filename = filename;
         m_data.clear();
-        ChannelType dummy;
-        //WaveFileHandler handler(m_filename);
-        if (LEFT == channel)
-        {
-            m_handler.readHeaderAndChannels(m_header, m_data, dummy);
-        }
-        else
+        // decode only the requested channel
+        std::vector<ChannelType> channels;
+        m_handler.readHeaderAndChannels(m_header, channels,
+            WaveFileHandler::ChannelMask(1) << channel);
+        if (static_cast<std::size_t>(channel) < channels.size())
         {
-            m_handler.readHeaderAndChannels(m_header, dummy, m_data);
+            m_data.swap(channels[channel]);
         }
         m_sampleFrequency = m_header.SampFreq;
     }
 
-    std::vector<std::vector<double>> WaveFile::load_next()
+    /**
+     * Reads and decodes next part of the file.
+     *
+     * @return one vector of samples for every channel in the file
+     */
+    std::vector<WaveFile::ChannelType> WaveFile::load_next()
     {
-        std::vector<std::vector<double>> channel_data;
-        ChannelType l_chan;
-        ChannelType r_chan;
-        m_handler.readPart(m_header, l_chan, r_chan, m_partSize);
-        if (m_header.Channels == 1)
-        {
-            channel_data.push_back(l_chan);
-        }
-        else if (m_header.Channels == 2)
-        {
-            channel_data.push_back(l_chan);
-            channel_data.push_back(r_chan);
-        }
-
+        std::vector<ChannelType> channel_data;
+        m_handler.readPart(m_header, channel_data, m_partSize);
         return channel_data;
     }
 
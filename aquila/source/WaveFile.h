@@ -36,16 +36,20 @@ namespace Aquila
      *
      * Binary files in WAVE format (.wav extension) can serve as data input for
      * Aquila. With this class, you can read the metadata and the actual
-     * waveform data from the file. The supported formats are:
+     * waveform data from the file. The supported formats are mono and
+     * stereo* recordings of:
      *
-     * - 8-bit mono
-     * - 8-bit stereo*
-     * - 16-bit mono
-     * - 16-bit stereo*
+     * - 8-bit, 16-bit, 24-bit and 32-bit integer PCM
+     * - 32-bit and 64-bit IEEE float
+     *
+     * including WAVE_FORMAT_EXTENSIBLE files. Sample values are not
+     * rescaled (see PcmDecoder).
      *
      * For stereo data, only only one of the channels is loaded from file.
      * By default this is the left channel, but you can control this from the
-     * constructor parameter.
+     * constructor parameter. Other channels are not decoded at all.
+     * Partial reads with load_next() return every channel of the file,
+     * so they work with any number of channels.
      *
      * There are no requirements for sample frequency of the data.
      */
@@ -66,7 +70,7 @@ namespace Aquila
 
         void load();
         void load(const std::string& filename, StereoChannel channel);
-        std::vector<std::vector<double>> load_next();
+        std::vector<ChannelType> load_next();
         static void save(const SignalSource& source, const std::string& file);
 
         /**
@@ -132,7 +136,7 @@ namespace Aquila
         /**
          * Returns number of bits per sample
          *
-         * @return 8 or 16
+         * @return 8, 16, 24, 32 or 64
          */
         virtual unsigned short getBitsPerSample() const
         {
@@ -17,62 +17,137 @@
 
 #include "WaveFileHandler.h"
 #include "WaveHeader.h"
+#include "PcmDecoder.h"
 #include "../Exceptions.h"
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <omp.h>
 
 namespace Aquila
 {
+    const WaveFileHandler::ChannelMask WaveFileHandler::ALL_CHANNELS;
+
     /**
      * Create the handler and tell it which file to read later.
      *
      * @param filename .wav file name
      */
     WaveFileHandler::WaveFileHandler(const std::string& filename):
-        m_filename(filename), m_bytes_read(0)
+        m_filename(filename), m_bytes_read(0), m_chunks()
     {
     }
 
     /**
-     * Reads WAVE header and audio channel data from file.
+     * Reads WAVE header from file, leaving the stream at the audio data.
+     *
+     * The chunks are walked by their sizes in a single pass: only the
+     * 8-byte chunk headers and the format chunk are read, the rest is
+     * skipped with one seek per chunk. All chunks are recorded in the
+     * chunk index (see getChunks()), including those after audio data.
+     *
+     * A data chunk which claims to extend past the end of file (as in
+     * interrupted recordings) is truncated to the actual file size.
      *
      * @param header reference to header instance which will be filled
-     * @param leftChannel reference to left audio channel
-     * @param rightChannel reference to right audio channel
+     * @throw Aquila::Exception if the file cannot be opened
+     * @throw Aquila::FormatException if fmt or data chunk is missing
      */
-
-    bool eq(const char c_str[], const std::string& pat)
-    {
-        for(size_t i = 0; i < pat.size(); i++)
-            if(c_str[i] != pat[i])
-                return false;
-        return true;
-    }
     void WaveFileHandler::readHeader(WaveHeader &header)
     {
-        if(m_fs_handle.is_open()) 
+        if (m_fs_handle.is_open())
             return; // if file is opened - then header had been already read
 
         m_fs_handle.open(m_filename.c_str(), std::ios::in | std::ios::binary);
-        if(!m_fs_handle.is_open())
-            throw new Aquila::Exception("Wrong file name");
+        if (!m_fs_handle.is_open())
+            throw Exception("Wrong file name: " + m_filename);
+
+        m_fs_handle.seekg(0, std::ios::end);
+        const std::uint64_t fileSize = static_cast<std::uint64_t>(m_fs_handle.tellg());
+        m_fs_handle.seekg(0, std::ios::beg);
 
-        m_fs_handle.read((char*)(&header), sizeof(WaveHeader)-sizeof(std::uint32_t)-4);
-        std::string riff_pat("RIFF");
-        if(!eq(header.RIFF, riff_pat))
-            throw new Aquila::Exception("Is not a RIFF file");
+        m_fs_handle.read(header.RIFF, sizeof(header.RIFF));
+        m_fs_handle.read((char*)(&header.DataLength), sizeof(header.DataLength));
+        m_fs_handle.read(header.WAVE, sizeof(header.WAVE));
+        if (!m_fs_handle || std::memcmp(header.RIFF, "RIFF", 4) != 0 ||
+            std::memcmp(header.WAVE, "WAVE", 4) != 0)
+            throw FormatException("Is not a RIFF file: " + m_filename);
 
-        std::string data_pat("data");
-        m_fs_handle.read(header.data, sizeof(header.data));
-        while (!eq(header.data, data_pat))
+        m_chunks.clear();
+        bool formatFound = false, dataFound = false;
+        std::uint64_t dataOffset = 0;
+        std::uint64_t position = 12;
+        while (position + 8 <= fileSize)
         {
-            m_fs_handle.seekg((long)m_fs_handle.tellg() - 3);
-            m_fs_handle.read(header.data, sizeof(header.data));
+            WaveChunk chunk;
+            m_fs_handle.seekg(position);
+            m_fs_handle.read(chunk.id, sizeof(chunk.id));
+            m_fs_handle.read((char*)(&chunk.size), sizeof(chunk.size));
+            if (!m_fs_handle)
+                break;
+            chunk.offset = position + 8;
+            const std::uint64_t available = fileSize - chunk.offset;
+            if (chunk.size > available)
+                chunk.size = static_cast<std::uint32_t>(available);
+            m_chunks.push_back(chunk);
+
+            if (!formatFound && std::memcmp(chunk.id, "fmt ", 4) == 0 &&
+                chunk.size >= 16)
+            {
+                // standard fields and WAVE_FORMAT_EXTENSIBLE extension
+                unsigned char body[40];
+                const std::size_t bodySize = std::min<std::size_t>(chunk.size, sizeof(body));
+                m_fs_handle.read(reinterpret_cast<char*>(body), bodySize);
+                std::memcpy(header.fmt_, chunk.id, 4);
+                header.SubBlockLength = chunk.size;
+                PcmDecoder::readFormatChunk(body, bodySize, header);
+                formatFound = true;
+            }
+            else if (!dataFound && std::memcmp(chunk.id, "data", 4) == 0)
+            {
+                std::memcpy(header.data, chunk.id, 4);
+                header.WaveSize = chunk.size;
+                dataOffset = chunk.offset;
+                dataFound = true;
+            }
+
+            // chunks are padded to an even size
+            position = chunk.offset + chunk.size + (chunk.size & 1);
         }
-        m_fs_handle.read((char*)(&header.WaveSize), sizeof(header.WaveSize));
+
+        if (!formatFound || !dataFound)
+            throw FormatException("Missing fmt or data chunk: " + m_filename);
+        // fail early for unsupported sample formats
+        PcmDecoder::getEncoding(header);
+
+        m_fs_handle.clear();
+        m_fs_handle.seekg(dataOffset);
+        m_bytes_read = 0;
+    }
+
+    /**
+     * Finds a chunk in the index built by readHeader().
+     *
+     * @param id four-character chunk identifier
+     * @return first chunk with this identifier or nullptr if there is none
+     */
+    const WaveChunk* WaveFileHandler::findChunk(const char id[4]) const
+    {
+        for (const auto& chunk : m_chunks)
+        {
+            if (std::memcmp(chunk.id, id, 4) == 0)
+                return &chunk;
+        }
+        return nullptr;
     }
 
+    /**
+     * Reads WAVE header and audio channel data from file.
+     *
+     * @param header reference to header instance which will be filled
+     * @param leftChannel reference to left audio channel
+     * @param rightChannel reference to right audio channel
+     */
     void WaveFileHandler::readHeaderAndChannels(WaveHeader &header,
         ChannelType& leftChannel, ChannelType& rightChannel)
     {
@@ -80,56 +155,159 @@ namespace Aquila
         // then as we know now the data size, we create a temporary
         // buffer and read raw data into that buffer
         readHeader(header);
-        short* data = new short[header.WaveSize/2];
-        m_fs_handle.read((char*)data, header.WaveSize);
+        std::vector<unsigned char> data(header.WaveSize);
+        m_fs_handle.read(reinterpret_cast<char*>(data.data()), header.WaveSize);
         m_fs_handle.close();
 
         // initialize data channels (using right channel only in stereo mode)
-        unsigned int channelSize = header.WaveSize/header.BytesPerSamp;
-        decodeData(header, data, channelSize, leftChannel, rightChannel);
+        std::size_t channelSize = header.WaveSize / header.BytesPerSamp;
+        decodeData(header, data.data(), channelSize, leftChannel, rightChannel);
+    }
 
-        // clear the buffer
-        delete [] data;
+    /**
+     * Reads WAVE header and selected channels from file.
+     *
+     * After the call there is one vector for every channel in the file;
+     * the channels which were not selected are left empty.
+     *
+     * @param header reference to header instance which will be filled
+     * @param channels vector of audio channels
+     * @param mask which channels to decode
+     */
+    void WaveFileHandler::readHeaderAndChannels(WaveHeader& header,
+        std::vector<ChannelType>& channels, ChannelMask mask)
+    {
+        readHeader(header);
+        std::vector<unsigned char> data(header.WaveSize);
+        m_fs_handle.read(reinterpret_cast<char*>(data.data()), header.WaveSize);
+        m_fs_handle.close();
+
+        std::size_t channelSize = header.WaveSize / header.BytesPerSamp;
+        decodeChannels(header, data.data(), channelSize, channels, mask);
     }
 
+    /**
+     * Reads and decodes next part of audio data.
+     *
+     * The part is rounded down to whole frames (samples of all channels).
+     *
+     * @param header header read by readHeader()
+     * @param leftChannel reference to left audio channel
+     * @param rightChannel reference to right audio channel
+     * @param partSize maximum part size in bytes
+     */
     void WaveFileHandler::readPart(const WaveHeader& header, ChannelType& leftChannel,
         ChannelType& rightChannel, size_t partSize)
     {
+        std::vector<ChannelType> channels;
+        readPart(header, channels, partSize, 0x3);
+        leftChannel.swap(channels[0]);
+        if (channels.size() >= 2)
+            rightChannel.swap(channels[1]);
+    }
+
+    /**
+     * Reads and decodes selected channels of next part of audio data.
+     *
+     * The part is rounded down to whole frames (samples of all channels).
+     *
+     * @param header header read by readHeader()
+     * @param channels vector of audio channels, unselected ones left empty
+     * @param partSize maximum part size in bytes
+     * @param mask which channels to decode
+     */
+    void WaveFileHandler::readPart(const WaveHeader& header,
+        std::vector<ChannelType>& channels, size_t partSize, ChannelMask mask)
+    {
+        const std::size_t remaining = header.WaveSize - m_bytes_read;
         size_t to_read = partSize;
-        if(partSize >= header.WaveSize - m_bytes_read)
-            to_read = header.WaveSize - m_bytes_read;
-        short* data = new short[(size_t)std::floor(to_read/2)];
-        m_fs_handle.read((char*)data, to_read);
+        if(partSize >= remaining)
+            to_read = remaining;
+        to_read -= to_read % header.BytesPerSamp;
+        std::vector<unsigned char> data(to_read);
+        m_fs_handle.read(reinterpret_cast<char*>(data.data()), to_read);
         m_bytes_read += to_read;
 
-        unsigned int channelSize = to_read/header.BytesPerSamp;
-        decodeData(header, data, channelSize, leftChannel, rightChannel);
-
-        // clear the buffer
-        delete [] data;
+        std::size_t channelSize = to_read / header.BytesPerSamp;
+        decodeChannels(header, data.data(), channelSize, channels, mask);
     }
 
-    void WaveFileHandler::decodeData(const WaveHeader& header, short* data, size_t channelSize, ChannelType& leftChannel, ChannelType& rightChannel)
+    /**
+     * Decodes selected channels of audio data in a single pass.
+     *
+     * Only the first 64 channels can be selected.
+     *
+     * @param header .wav header
+     * @param data raw data buffer
+     * @param channelSize number of samples in each channel
+     * @param channels resized to the number of channels in the data;
+     *                 the channels which are not selected are left empty
+     * @param mask which channels to decode
+     * @throw Aquila::FormatException for unsupported formats
+     */
+    void WaveFileHandler::decodeChannels(const WaveHeader& header,
+                                         const unsigned char* data,
+                                         std::size_t channelSize,
+                                         std::vector<ChannelType>& channels,
+                                         ChannelMask mask)
     {
-        leftChannel.resize(channelSize);
-        if (2 == header.Channels)
-            rightChannel.resize(channelSize);
-
-        // most important conversion happens right here
-        if (16 == header.BitsPerSamp)
-        {
-            if (2 == header.Channels)
-                decode16bitStereo(leftChannel, rightChannel, data, channelSize);
-            else
-                decode16bit(leftChannel, data, channelSize);
-        }
-        else
+        const PcmDecoder::Encoding encoding = PcmDecoder::getEncoding(header);
+        channels.resize(header.Channels);
+        std::vector<SampleType*> outputs(header.Channels, nullptr);
+        for (unsigned int i = 0; i < header.Channels; ++i)
         {
-            if (2 == header.Channels)
-                decode8bitStereo(leftChannel, rightChannel, data, channelSize);
+            if (i < 64 && (mask >> i) & 1)
+            {
+                channels[i].resize(channelSize);
+                outputs[i] = channels[i].data();
+            }
             else
-                decode8bit(leftChannel, data, channelSize);
+            {
+                channels[i].clear();
+            }
         }
+        PcmDecoder::deinterleave(encoding, data, channelSize, header.Channels,
+                                 outputs.data());
+    }
+
+    /**
+     * Decodes first two channels of audio data.
+     *
+     * @param header .wav header
+     * @param data raw data buffer
+     * @param channelSize number of samples in each channel
+     * @param leftChannel first channel (the only one in mono recordings)
+     * @param rightChannel second channel, untouched in mono recordings
+     * @throw Aquila::FormatException for unsupported formats
+     */
+    void WaveFileHandler::decodeData(const WaveHeader& header,
+                                     const unsigned char* data,
+                                     std::size_t channelSize,
+                                     ChannelType& leftChannel,
+                                     ChannelType& rightChannel)
+    {
+        std::vector<ChannelType> channels;
+        decodeChannels(header, data, channelSize, channels, 0x3);
+        leftChannel.swap(channels[0]);
+        if (channels.size() >= 2)
+            rightChannel.swap(channels[1]);
+    }
+
+    /**
+     * Decodes first two channels of audio data.
+     *
+     * @param header .wav header
+     * @param data raw data buffer
+     * @param channelSize number of samples in each channel
+     * @param leftChannel first channel (the only one in mono recordings)
+     * @param rightChannel second channel, untouched in mono recordings
+     */
+    void WaveFileHandler::decodeData(const WaveHeader& header, short* data,
+                                     size_t channelSize, ChannelType& leftChannel,
+                                     ChannelType& rightChannel)
+    {
+        decodeData(header, reinterpret_cast<const unsigned char*>(data),
+                   channelSize, leftChannel, rightChannel);
     }
 
     /**
@@ -146,14 +324,15 @@ namespace Aquila
         fs.write((const char*)(&header), sizeof(WaveHeader));
 
         std::size_t waveSize = header.WaveSize;
-        short* data = new short[waveSize/2];
+        // round up, as there may be an odd number of 8-bit samples
+        short* data = new short[(waveSize + 1)/2];
         if (16 == header.BitsPerSamp)
         {
             encode16bit(source, data, waveSize/2);
         }
         else
         {
-            encode8bit(source, data, waveSize/2);
+            encode8bit(source, data, (waveSize + 1)/2);
         }
         fs.write((const char*)data, waveSize);
 
@@ -206,11 +385,9 @@ namespace Aquila
      */
     void WaveFileHandler::decode16bit(ChannelType& channel, short* data, std::size_t channelSize)
     {
-        #pragma omp parallel for
-        for (int i = 0; i < channelSize; ++i)
-        {
-            channel[i] = data[i];
-        }
+        PcmDecoder::decode(PcmDecoder::Int16,
+                           reinterpret_cast<const unsigned char*>(data),
+                           channelSize, 1, 0, channel.data());
     }
 
     /**
@@ -224,12 +401,10 @@ namespace Aquila
     void WaveFileHandler::decode16bitStereo(ChannelType& leftChannel,
         ChannelType& rightChannel, short* data, std::size_t channelSize)
     {
-        #pragma omp parallel for
-        for (int i = 0; i < channelSize; ++i)
-        {
-            leftChannel[i] = data[2*i];
-            rightChannel[i] = data[2*i+1];
-        }
+        SampleType* outputs[2] = {leftChannel.data(), rightChannel.data()};
+        PcmDecoder::deinterleave(PcmDecoder::Int16,
+                                 reinterpret_cast<const unsigned char*>(data),
+                                 channelSize, 2, outputs);
     }
 
     /**
@@ -241,15 +416,10 @@ namespace Aquila
      */
     void WaveFileHandler::decode8bit(ChannelType& channel, short* data, std::size_t channelSize)
     {
-        // low byte and high byte of a 16b word
-        unsigned char lb, hb;
-        #pragma omp parallel for private(lb) private(hb)
-        for (int i = 0; i < channelSize; ++i)
-        {
-            splitBytes(data[i / 2], lb, hb);
-            // only one channel collects samples
-            channel[i] = lb - 128;
-        }
+        // values are unipolar, so they are moved by half of the dynamic range
+        PcmDecoder::decode(PcmDecoder::UInt8,
+                           reinterpret_cast<const unsigned char*>(data),
+                           channelSize, 1, 0, channel.data());
     }
 
     /**
@@ -263,18 +433,10 @@ namespace Aquila
     void WaveFileHandler::decode8bitStereo(ChannelType& leftChannel,
         ChannelType& rightChannel, short* data, std::size_t channelSize)
     {
-        // low byte and high byte of a 16b word
-        unsigned char lb, hb;
-        #pragma omp parallel for private(lb) private(hb)
-        for (int i = 0; i < channelSize; ++i)
-        {
-            splitBytes(data[i / 2], lb, hb);
-            // left channel is in low byte, right in high
-            // values are unipolar, so we move them by half
-            // of the dynamic range
-            leftChannel[i] = lb - 128;
-            rightChannel[i] = hb - 128;
-        }
+        SampleType* outputs[2] = {leftChannel.data(), rightChannel.data()};
+        PcmDecoder::deinterleave(PcmDecoder::UInt8,
+                                 reinterpret_cast<const unsigned char*>(data),
+                                 channelSize, 2, outputs);
     }
 
     /**
@@ -297,32 +459,26 @@ namespace Aquila
     /**
      * Encodes the source data as an array of 8-bit values stored in shorts.
      *
+     * Samples are stored in file order, so each short holds an even
+     * sample in its first (low) byte and the next one in its high byte.
+     * The high byte of the last short is silence if there is an odd
+     * number of samples.
+     *
      * @param source original signal source
      * @param data the data buffer to be written
      * @param dataSize size of the buffer
      */
     void WaveFileHandler::encode8bit(const SignalSource& source, short* data, std::size_t dataSize)
     {
+        const std::size_t samplesCount = source.getSamplesCount();
         #pragma omp parallel for
         for (int i = 0; i < dataSize; ++i)
         {
-            unsigned char sample1 = static_cast<unsigned char>(source.sample(2 * i) + 128);
-            unsigned char sample2 = static_cast<unsigned char>(source.sample(2 * i + 1) + 128);
-            short hb = sample1, lb = sample2;
-            data[i] = ((hb << 8) & 0xFF00) | (lb & 0x00FF);
+            const std::size_t first = 2 * i;
+            std::uint16_t lb = static_cast<unsigned char>(source.sample(first) + 128);
+            std::uint16_t hb = first + 1 < samplesCount ?
+                static_cast<unsigned char>(source.sample(first + 1) + 128) : 128;
+            data[i] = static_cast<short>((hb << 8) | lb);
         }
     }
-
-    /**
-     * Splits a 16-b number to lower and upper byte.
-     *
-     * @param twoBytes number to split
-     * @param lb lower byte (by reference)
-     * @param hb upper byte (by reference)
-     */
-    void WaveFileHandler::splitBytes(short twoBytes, unsigned char& lb, unsigned char& hb)
-    {
-        lb = twoBytes & 0x00FF;
-        hb = (twoBytes >> 8) & 0x00FF;
-    }
 }
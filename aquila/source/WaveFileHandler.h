@@ -21,8 +21,10 @@
 #include "../global.h"
 #include "SignalSource.h"
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <fstream>
+#include <vector>
 
 namespace Aquila
 {
@@ -31,25 +33,83 @@ namespace Aquila
      */
     struct WaveHeader;
 
+    /**
+     * Location of a single RIFF chunk in a .wav file.
+     */
+    struct WaveChunk
+    {
+        /**
+         * Four-character chunk identifier, e.g. "fmt ", "data", "LIST".
+         */
+        char id[4];
+
+        /**
+         * Size of chunk body in bytes (without padding).
+         */
+        std::uint32_t size;
+
+        /**
+         * Position of chunk body in the file.
+         */
+        std::uint64_t offset;
+    };
+
     /**
      * A utility class to handle loading and saving of .wav files.
      */
     class AQUILA_EXPORT WaveFileHandler
     {
     public:
+        /**
+         * Channel selection, bit n set means that channel n is decoded.
+         */
+        typedef std::uint64_t ChannelMask;
+
+        /**
+         * Selects all channels.
+         */
+        static const ChannelMask ALL_CHANNELS = ~ChannelMask(0);
+
         WaveFileHandler(const std::string& filename);
 
         void readHeader(WaveHeader& header);
         void readHeaderAndChannels(WaveHeader& header,
             ChannelType& leftChannel,
             ChannelType& rightChannel);
+        void readHeaderAndChannels(WaveHeader& header,
+            std::vector<ChannelType>& channels,
+            ChannelMask mask = ALL_CHANNELS);
         void readPart(const WaveHeader& header,
             ChannelType& leftChannel,
             ChannelType& rightChannel,
             size_t partSize);
+        void readPart(const WaveHeader& header,
+            std::vector<ChannelType>& channels,
+            size_t partSize,
+            ChannelMask mask = ALL_CHANNELS);
 
         void save(const SignalSource& source);
 
+        /**
+         * Returns all chunks found by readHeader(), in file order.
+         *
+         * @return chunk index
+         */
+        const std::vector<WaveChunk>& getChunks() const
+        {
+            return m_chunks;
+        }
+
+        const WaveChunk* findChunk(const char id[4]) const;
+
+        static void decodeChannels(const WaveHeader& header,
+                                   const unsigned char* data,
+                                   std::size_t channelSize,
+                                   std::vector<ChannelType>& channels,
+                                   ChannelMask mask = ALL_CHANNELS);
+        void decodeData(const WaveHeader& header, const unsigned char* data,
+                        std::size_t channelSize, ChannelType& leftChannel,
+                        ChannelType& rightChannel);
         void decodeData(const WaveHeader& header, short* data, size_t channelSize,
                         ChannelType& leftChannel, ChannelType& rightChannel);
 
@@ -68,14 +128,18 @@ namespace Aquila
 
     private:
         void createHeader(const SignalSource& source, WaveHeader& header);
-        static void splitBytes(short twoBytes, unsigned char& lb, unsigned char& hb);
 
         /**
          * Destination or source file.
          */
         const std::string m_filename;
         std::fstream m_fs_handle;
-        long m_bytes_read;
+        std::size_t m_bytes_read;
+
+        /**
+         * Index of all chunks in the file.
+         */
+        std::vector<WaveChunk> m_chunks;
     };
 }
 
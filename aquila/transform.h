@@ -23,9 +23,16 @@
 #include "transform/Dft.h"
 #include "transform/AquilaFft.h"
 #include "transform/OouraFft.h"
+#include "transform/Radix4Fft.h"
+#include "transform/MixedRadixFft.h"
+#include "transform/BluesteinFft.h"
 #include "transform/FftFactory.h"
 #include "transform/Dct.h"
+#include "transform/DctPlan.h"
 #include "transform/Mfcc.h"
+#include "transform/StreamingMfcc.h"
 #include "transform/Spectrogram.h"
+#include "transform/Stft.h"
+#include "transform/Istft.h"
 
 #endif // AQUILA_TRANSFORM_H
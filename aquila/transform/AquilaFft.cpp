@@ -28,187 +28,269 @@ namespace Aquila
     const ComplexType AquilaFft::j(0, 1);
 
     /**
-     * Applies the transformation to the signal.
+     * Initializes the transform for a given input length.
      *
-     * @param x input signal
-     * @return calculated spectrum
+     * Twiddle factors for all stages are calculated here, so the
+     * transforms only read them and may run concurrently.
+     *
+     * @param length input signal size (usually a power of 2)
      */
-    SpectrumType AquilaFft::fft(const SampleType x[])
+    AquilaFft::AquilaFft(std::size_t length):
+        Fft(length), stageWi()
     {
-        SpectrumType spectrum(N);
-
-        // bit-reversing the samples - a requirement of radix-2
-        // instead of reversing in place, put the samples to result array
-        unsigned int a = 1, b = 0, c = 0;
-        std::copy(x, x + N, std::begin(spectrum));
-        for (b = 1; b < N; ++b)
+        const unsigned int numStages = getNumStages();
+        stageWi.resize(numStages + 1);
+        for (unsigned int k = 1; k <= numStages; ++k)
         {
-            if (b < a)
-            {
-                spectrum[a - 1] = x[b - 1];
-                spectrum[b - 1] = x[a - 1];
-            }
-            c = N / 2;
-            while (c < a)
+            // L = 2^k - DFT block length and offset
+            // M = 2^(k-1) - butterflies per block, butterfly width
+            // W - Fourier base multiplying factor
+            unsigned int L = 1 << k;
+            unsigned int M = 1 << (k - 1);
+            // (calculated in double precision regardless of ComplexType)
+            const std::complex<double> W = std::polar(
+                1.0, -2.0 * M_PI / static_cast<double>(L));
+            std::complex<double> Wp(1.0);
+            std::vector<ComplexType>& Wi = stageWi[k];
+            Wi.resize(M + 1);
+            for (unsigned int p = 0; p <= M; ++p)
             {
-                a -= c;
-                c /= 2;
+                Wi[p] = ComplexType(Wp);
+                Wp *= W;
             }
-            a += c;
         }
+    }
 
-        // FFT calculation using "butterflies"
-        // code ported from Matlab, based on book by Tomasz P. Zieliński
-
-        // FFT stages count
-        unsigned int numStages = static_cast<unsigned int>(
-            std::log(static_cast<double>(N)) / LN_2);
+    /**
+     * Applies the transformation to the signal.
+     *
+     * @param x input signal
+     * @param spectrum output spectrum
+     */
+    void AquilaFft::fft(const SampleType x[], ComplexType spectrum[]) const
+    {
+        std::copy(x, x + N, spectrum);
+        bitReverse(spectrum, N);
+        butterflies(spectrum, N, false);
+    }
 
-        // L = 2^k - DFT block length and offset
-        // M = 2^(k-1) - butterflies per block, butterfly width
-        // p - butterfly index
-        // q - block index
-        // r - index of sample in butterfly
-        // Wi - starting value of Fourier base coefficient
-        unsigned int L = 0, M = 0, p = 0, q = 0, r = 0;
-        ComplexType Wi(0, 0), Temp(0, 0);
+    /**
+     * Applies the inverse transform to the spectrum.
+     *
+     * Real part of the inverse of any spectrum is equal to the inverse of
+     * its conjugate-symmetric part, so the real inverse transform is used.
+     *
+     * @param spectrum input spectrum
+     * @param x output signal
+     */
+    void AquilaFft::ifft(const ComplexType spectrum[], SampleType x[]) const
+    {
+        inverseReal(spectrum, true, x);
+    }
 
-        ComplexType** Wi_cache = getCachedFftWi(numStages);
+    /**
+     * Applies the transformation to a real signal.
+     *
+     * Even and odd samples are packed into real and imaginary parts of
+     * a complex signal of half the length. After an N/2-point FFT the two
+     * interleaved spectra are separated using their conjugate symmetry
+     * and combined with one last radix-2 stage.
+     *
+     * @param x input signal
+     * @param spectrum output half spectrum
+     */
+    void AquilaFft::rfft(const SampleType x[], ComplexType spectrum[]) const
+    {
+        const std::size_t M = N / 2;
+        if (M == 0)
+        {
+            spectrum[0] = x[0];
+            return;
+        }
 
-        // iterate over the stages
-        for (unsigned int k = 1; k <= numStages; ++k)
+        for (std::size_t m = 0; m < M; ++m)
         {
-            L = 1 << k;
-            M = 1 << (k - 1);
-            Wi = Wi_cache[k][0];
+            spectrum[m] = ComplexType(x[2 * m], x[2 * m + 1]);
+        }
+        bitReverse(spectrum, M);
+        butterflies(spectrum, M, false);
 
-            // iterate over butterflies
-            for (p = 1; p <= M; ++p)
-            {
-                // iterate over blocks
-                for (q = p; q <= N; q += L)
-                {
-                    r = q + M;
-                    Temp = spectrum[r - 1] * Wi;
-                    spectrum[r - 1] = spectrum[q - 1] - Temp;
-                    spectrum[q - 1] = spectrum[q - 1] + Temp;
-                }
-                Wi = Wi_cache[k][p];
-            }
+        // twiddle factors of the last stage are W_N^k for k = 0 .. N/2
+        const ComplexType* W = stageWi[getNumStages()].data();
+        const SampleType half(0.5);
+        const ComplexType Z0 = spectrum[0];
+        spectrum[0] = Z0.real() + Z0.imag();
+        spectrum[M] = Z0.real() - Z0.imag();
+        for (std::size_t k = 1; k <= M / 2; ++k)
+        {
+            const ComplexType Zk = spectrum[k], Zmk = std::conj(spectrum[M - k]);
+            // spectra of even (E) and odd (O) samples at bin k
+            const ComplexType Ek = half * (Zk + Zmk);
+            const ComplexType Ok = -half * j * (Zk - Zmk);
+            // ... and at bin M-k, using conjugate symmetry
+            const ComplexType Emk = std::conj(Ek), Omk = std::conj(Ok);
+            spectrum[k] = Ek + W[k] * Ok;
+            spectrum[M - k] = Emk + W[M - k] * Omk;
         }
+    }
 
-        return spectrum;
+    /**
+     * Applies the inverse transform to a half spectrum.
+     *
+     * @param spectrum first N/2+1 bins of the spectrum
+     * @param x output signal
+     */
+    void AquilaFft::irfft(const ComplexType spectrum[], SampleType x[]) const
+    {
+        inverseReal(spectrum, false, x);
     }
 
     /**
-     * Applies the inverse transform to the spectrum.
+     * Calculates a real inverse transform directly in the output array.
+     *
+     * Reverses the steps of rfft(): the spectra of even and odd samples
+     * are recovered from the half spectrum, packed as a complex spectrum
+     * of length N/2 (which fits exactly in the output array) and
+     * transformed back with an N/2-point inverse FFT.
      *
      * @param spectrum input spectrum
+     * @param symmetrize true if spectrum is a full spectrum whose
+     *                   conjugate-symmetric part should be used
      * @param x output signal
      */
-    void AquilaFft::ifft(SpectrumType spectrum, double x[])
+    void AquilaFft::inverseReal(const ComplexType spectrum[], bool symmetrize,
+                                SampleType x[]) const
     {
-        SpectrumType spectrumCopy(spectrum);
-        unsigned int a = 1, b = 0, c = 0;
-        for (b = 1; b < N; ++b)
-        {
-            if (b < a)
-            {
-                spectrumCopy[a - 1] = spectrum[b - 1];
-                spectrumCopy[b - 1] = spectrum[a - 1];
-            }
-            c = N / 2;
-            while (c < a)
+        const SampleType half(0.5);
+        // k-th bin of the conjugate-symmetric part of the spectrum
+        auto bin = [&] (std::size_t k) -> ComplexType {
+            if (!symmetrize)
             {
-                a -= c;
-                c /= 2;
+                return spectrum[k];
             }
-            a += c;
+            return half * (spectrum[k] + std::conj(spectrum[(N - k) % N]));
+        };
+
+        const std::size_t M = N / 2;
+        if (M == 0)
+        {
+            x[0] = spectrum[0].real();
+            return;
         }
 
-        unsigned int numStages = static_cast<unsigned int>(
-            std::log(static_cast<double>(N)) / LN_2);
-        unsigned int L = 0, M = 0, p = 0, q = 0, r = 0;
-        ComplexType Wi(0, 0), Temp(0, 0);
-        ComplexType** Wi_cache = getCachedFftWi(numStages);
-        for (unsigned int k = 1; k <= numStages; ++k)
+        const ComplexType* W = stageWi[getNumStages()].data();
+        ComplexType* packed = reinterpret_cast<ComplexType*>(x);
+        for (std::size_t k = 0; k < M; ++k)
         {
-            L = 1 << k;
-            M = 1 << (k - 1);
-            Wi = -Wi_cache[k][0];
-            for (p = 1; p <= M; ++p)
-            {
-                for (q = p; q <= N; q += L)
-                {
-                    r = q + M;
-                    Temp = spectrumCopy[r - 1] * Wi;
-                    spectrumCopy[r - 1] = spectrumCopy[q - 1] - Temp;
-                    spectrumCopy[q - 1] = spectrumCopy[q - 1] + Temp;
-                }
-                Wi = -Wi_cache[k][p];
-            }
+            const ComplexType Xk = bin(k), Xmk = std::conj(bin(M - k));
+            const ComplexType Ek = half * (Xk + Xmk);
+            const ComplexType Ok = half * (Xk - Xmk) * std::conj(W[k]);
+            packed[k] = Ek + j * Ok;
         }
+        bitReverse(packed, M);
+        butterflies(packed, M, true);
 
-        for (unsigned int k = 0; k < N; ++k)
+        // the packed signal is exactly x[0], x[1], ..., just needs scaling
+        for (std::size_t i = 0; i < N; ++i)
         {
-            x[k] = std::abs(spectrumCopy[k]) / static_cast<double>(N);
+            x[i] /= static_cast<double>(M);
         }
     }
 
     /**
-     * Returns a table of Wi (twiddle factors) stored in cache.
+     * Returns the number of radix-2 stages for the transform length.
      *
-     * @param numStages the FFT stages count
-     * @return pointer to an array of pointers to arrays of complex numbers
+     * @return log2(N)
      */
-    ComplexType** AquilaFft::getCachedFftWi(unsigned int numStages)
+    unsigned int AquilaFft::getNumStages() const
     {
-        fftWiCacheKeyType key = numStages;
-        // cache hit, return immediately
-        if (fftWiCache.find(key) != fftWiCache.end())
-        {
-            return fftWiCache[key];
-        }
+        return static_cast<unsigned int>(
+            std::log(static_cast<double>(N)) / LN_2 + 0.5);
+    }
 
-        // nothing in cache, calculate twiddle factors
-        ComplexType** Wi = new ComplexType*[numStages + 1];
-        for (unsigned int k = 1; k <= numStages; ++k)
+    /**
+     * Reorders the data in place to bit-reversed order.
+     *
+     * Bit reversal of the samples is a requirement of radix-2.
+     *
+     * @param data complex data array
+     * @param length array length (a power of 2)
+     */
+    void AquilaFft::bitReverse(ComplexType data[], std::size_t length) const
+    {
+        unsigned int a = 1, b = 0, c = 0;
+        for (b = 1; b < length; ++b)
         {
-            // L = 2^k - DFT block length and offset
-            // M = 2^(k-1) - butterflies per block, butterfly width
-            // W - Fourier base multiplying factor
-            unsigned int L = 1 << k;
-            unsigned int M = 1 << (k - 1);
-            ComplexType W = exp((-j) * 2.0 * M_PI / static_cast<double>(L));
-            Wi[k] = new ComplexType[M + 1];
-            Wi[k][0] = ComplexType(1.0);
-            for (unsigned int p = 1; p <= M; ++p)
+            if (b < a)
             {
-                Wi[k][p] = Wi[k][p - 1] * W;
+                std::swap(data[a - 1], data[b - 1]);
             }
+            c = length / 2;
+            while (c < a)
+            {
+                a -= c;
+                c /= 2;
+            }
+            a += c;
         }
-
-        // store in cache and return
-        fftWiCache[key] = Wi;
-
-        return Wi;
     }
 
     /**
-     * Clears the twiddle factor cache.
+     * Runs the FFT stages on bit-reversed data, in place.
+     *
+     * The inverse transform uses conjugated twiddle factors and does not
+     * scale the output.
+     *
+     * @param data complex data array in bit-reversed order
+     * @param length array length (a power of 2, not larger than N)
+     * @param inverse whether to calculate the inverse transform
      */
-    void AquilaFft::clearFftWiCache()
+    void AquilaFft::butterflies(ComplexType data[], std::size_t length,
+                                bool inverse) const
     {
-        for (auto it = fftWiCache.begin(); it != fftWiCache.end(); it++)
+        // FFT calculation using "butterflies"
+        // code ported from Matlab, based on book by Tomasz P. Zieliński
+
+        // FFT stages count
+        unsigned int numStages = 0;
+        while ((static_cast<std::size_t>(1) << numStages) < length)
+        {
+            ++numStages;
+        }
+
+        // L = 2^k - DFT block length and offset
+        // M = 2^(k-1) - butterflies per block, butterfly width
+        // p - butterfly index
+        // q - block index
+        // r - index of sample in butterfly
+        // Wi - starting value of Fourier base coefficient
+        unsigned int L = 0, M = 0, p = 0, q = 0, r = 0;
+        ComplexType Wi(0, 0), Temp(0, 0);
+
+        // iterate over the stages
+        for (unsigned int k = 1; k <= numStages; ++k)
         {
-            ComplexType** c = it->second;
-            unsigned int numStages = it->first;
-            for (unsigned int i = 1; i <= numStages; ++i)
+            L = 1 << k;
+            M = 1 << (k - 1);
+            Wi = stageWi[k][0];
+
+            // iterate over butterflies
+            for (p = 1; p <= M; ++p)
             {
-                delete [] c[i];
+                if (inverse)
+                {
+                    Wi = std::conj(Wi);
+                }
+                // iterate over blocks
+                for (q = p; q <= length; q += L)
+                {
+                    r = q + M;
+                    Temp = data[r - 1] * Wi;
+                    data[r - 1] = data[q - 1] - Temp;
+                    data[q - 1] = data[q - 1] + Temp;
+                }
+                Wi = stageWi[k][p];
             }
-
-            delete [] c;
         }
     }
 }
@@ -19,8 +19,7 @@
 #define AQUILAFFT_H
 
 #include "Fft.h"
-#include <map>
-#include <utility>
+#include <vector>
 
 namespace Aquila
 {
@@ -35,28 +34,17 @@ namespace Aquila
     class AQUILA_EXPORT AquilaFft : public Fft
     {
     public:
-        /**
-         * Initializes the transform for a given input length.
-         *
-         * @param length input signal size (usually a power of 2)
-         */
-        AquilaFft(std::size_t length):
-            Fft(length), fftWiCache()
-        {
-        }
+        AquilaFft(std::size_t length);
 
-        /**
-         * Destroys the transform object.
-         *
-         * @todo clear the cache somewhere else, not here!
-         */
-        ~AquilaFft()
-        {
-            clearFftWiCache();
-        }
+        using Fft::fft;
+        using Fft::ifft;
+        using Fft::rfft;
+        using Fft::irfft;
 
-        virtual SpectrumType fft(const SampleType x[]);
-        virtual void ifft(SpectrumType spectrum, double x[]);
+        virtual void fft(const SampleType x[], ComplexType spectrum[]) const;
+        virtual void ifft(const ComplexType spectrum[], SampleType x[]) const;
+        virtual void rfft(const SampleType x[], ComplexType spectrum[]) const;
+        virtual void irfft(const ComplexType spectrum[], SampleType x[]) const;
 
     private:
         /**
@@ -65,23 +53,19 @@ namespace Aquila
         static const ComplexType j;
 
         /**
-         * Type of the twiddle factor cache key.
+         * Twiddle factors for each stage (the 0-th one is unused).
          */
-        typedef unsigned int fftWiCacheKeyType;
+        std::vector<std::vector<ComplexType>> stageWi;
 
-        /**
-         * Type of the twiddle factor cache.
-         */
-        typedef std::map<fftWiCacheKeyType, ComplexType**> fftWiCacheType;
+        unsigned int getNumStages() const;
 
-        /**
-         * Twiddle factor cache - implemented as a map.
-         */
-        fftWiCacheType fftWiCache;
+        void bitReverse(ComplexType data[], std::size_t length) const;
 
-        ComplexType** getCachedFftWi(unsigned int numStages);
+        void inverseReal(const ComplexType spectrum[], bool symmetrize,
+                         SampleType x[]) const;
 
-        void clearFftWiCache();
+        void butterflies(ComplexType data[], std::size_t length,
+                         bool inverse) const;
     };
 }
 
@@ -0,0 +1,248 @@
+/**
+ * @file BluesteinFft.cpp
+ *
+ * Bluestein's (chirp z-transform) FFT algorithm for any length.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#include "BluesteinFft.h"
+#include "FftFactory.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Aquila
+{
+    namespace
+    {
+        /**
+         * Returns the smallest power of 2 not less than 2*length-1.
+         *
+         * @param length FFT length
+         * @return convolution length
+         */
+        std::size_t convolutionLength(std::size_t length)
+        {
+            std::size_t m = 1;
+            while (m < 2 * length - 1)
+            {
+                m *= 2;
+            }
+            return m;
+        }
+
+        /**
+         * Multiplies two complex numbers.
+         *
+         * @param a first factor
+         * @param b second factor
+         * @return product
+         */
+        inline ComplexType multiply(const ComplexType& a, const ComplexType& b)
+        {
+            return ComplexType(a.real() * b.real() - a.imag() * b.imag(),
+                               a.real() * b.imag() + a.imag() * b.real());
+        }
+    }
+
+    /**
+     * Prepares the chirp and its spectrum.
+     *
+     * The convolution uses Radix4Fft, which is the fastest backend
+     * calculating full spectra of power of 2 lengths. It is chosen
+     * explicitly, as the default backend could be measured, and
+     * measuring includes Bluestein transforms of length M.
+     *
+     * @param length FFT length (any positive number)
+     */
+    BluesteinFft::BluesteinFft(std::size_t length):
+        Fft(length), M(convolutionLength(length)),
+        convolutionFft(FftFactory::getFft(M, FftFactory::Radix4Backend)),
+        chirp(length), chirpSpectrum(M)
+    {
+        for (std::size_t n = 0; n < N; ++n)
+        {
+            // n^2 mod 2N keeps the phase accurate for large n
+            const double phase = -M_PI * ((n * n) % (2 * N)) / N;
+            chirp[n] = ComplexType(std::cos(phase), std::sin(phase));
+        }
+
+        std::vector<SampleType> re(M, 0.0), im(M, 0.0);
+        re[0] = chirp[0].real();
+        im[0] = -chirp[0].imag();
+        for (std::size_t n = 1; n < N; ++n)
+        {
+            re[n] = re[M - n] = chirp[n].real();
+            im[n] = im[M - n] = -chirp[n].imag();
+        }
+        std::vector<ComplexType> R(M), I(M);
+        convolutionFft->fft(&re[0], &R[0]);
+        convolutionFft->fft(&im[0], &I[0]);
+        for (std::size_t k = 0; k < M; ++k)
+        {
+            chirpSpectrum[k] = R[k] + ComplexType(-I[k].imag(), I[k].real());
+        }
+    }
+
+    /**
+     * Applies the transformation to the signal.
+     *
+     * @param x input signal
+     * @param spectrum output spectrum
+     */
+    void BluesteinFft::fft(const SampleType x[], ComplexType spectrum[]) const
+    {
+        ComplexType* in = workArea();
+        std::copy(x, x + N, in);
+        cfft(in, spectrum, in + 2 * N, realWorkArea());
+    }
+
+    /**
+     * Applies the inverse transform to the spectrum.
+     *
+     * @param spectrum input spectrum
+     * @param x output signal
+     */
+    void BluesteinFft::ifft(const ComplexType spectrum[], SampleType x[]) const
+    {
+        ComplexType* in = workArea();
+        ComplexType* out = in + N;
+        for (std::size_t k = 0; k < N; ++k)
+        {
+            in[k] = std::conj(spectrum[k]);
+        }
+        cfft(in, out, in + 2 * N, realWorkArea());
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            x[i] = out[i].real() / N;
+        }
+    }
+
+    /**
+     * Applies the transformation to a real signal.
+     *
+     * @param x input signal
+     * @param spectrum output half spectrum
+     */
+    void BluesteinFft::rfft(const SampleType x[], ComplexType spectrum[]) const
+    {
+        ComplexType* in = workArea();
+        ComplexType* out = in + N;
+        std::copy(x, x + N, in);
+        cfft(in, out, in + 2 * N, realWorkArea());
+        std::copy(out, out + getRealSpectrumSize(), spectrum);
+    }
+
+    /**
+     * Applies the inverse transform to a half spectrum.
+     *
+     * @param spectrum first N/2+1 bins of the spectrum
+     * @param x output signal
+     */
+    void BluesteinFft::irfft(const ComplexType spectrum[], SampleType x[]) const
+    {
+        ComplexType* in = workArea();
+        ComplexType* out = in + N;
+        for (std::size_t k = 0; k <= N / 2; ++k)
+        {
+            in[k] = std::conj(spectrum[k]);
+        }
+        for (std::size_t k = 1; k < N - N / 2; ++k)
+        {
+            in[N - k] = spectrum[k];
+        }
+        cfft(in, out, in + 2 * N, realWorkArea());
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            x[i] = out[i].real() / N;
+        }
+    }
+
+    /**
+     * Applies the forward transform to a complex signal.
+     *
+     * The signal multiplied by the chirp is convolved with the conjugated
+     * chirp. Its spectrum is assembled from spectra of the real and
+     * imaginary parts. Real and imaginary parts of the convolution are
+     * real parts of inverse transforms of the product P and of -jP.
+     *
+     * @param x input signal (N values)
+     * @param spectrum output spectrum (room for N values)
+     * @param work work area for 2*M complex values
+     * @param realWork work area for 2*M real values
+     */
+    void BluesteinFft::cfft(const ComplexType x[], ComplexType spectrum[],
+                            ComplexType work[], SampleType realWork[]) const
+    {
+        SampleType* re = realWork;
+        SampleType* im = realWork + M;
+        for (std::size_t n = 0; n < N; ++n)
+        {
+            const ComplexType a = multiply(x[n], chirp[n]);
+            re[n] = a.real();
+            im[n] = a.imag();
+        }
+        std::fill(re + N, re + M, SampleType(0));
+        std::fill(im + N, im + M, SampleType(0));
+
+        ComplexType* R = work;
+        ComplexType* I = work + M;
+        convolutionFft->fft(re, R);
+        convolutionFft->fft(im, I);
+        for (std::size_t k = 0; k < M; ++k)
+        {
+            // A = R + jI
+            const ComplexType A(R[k].real() - I[k].imag(),
+                                R[k].imag() + I[k].real());
+            const ComplexType P = multiply(A, chirpSpectrum[k]);
+            R[k] = P;
+            I[k] = ComplexType(P.imag(), -P.real());
+        }
+        convolutionFft->ifft(R, re);
+        convolutionFft->ifft(I, im);
+
+        for (std::size_t k = 0; k < N; ++k)
+        {
+            spectrum[k] = multiply(chirp[k], ComplexType(re[k], im[k]));
+        }
+    }
+
+    /**
+     * Returns the calling thread's work area.
+     *
+     * @return pointer to 2*N + 2*M complex values
+     */
+    ComplexType* BluesteinFft::workArea() const
+    {
+        thread_local std::vector<ComplexType> area;
+        if (area.size() < 2 * (N + M))
+        {
+            area.resize(2 * (N + M));
+        }
+        return area.data();
+    }
+
+    /**
+     * Returns the calling thread's work area for real signals.
+     *
+     * @return pointer to 2*M real values
+     */
+    SampleType* BluesteinFft::realWorkArea() const
+    {
+        thread_local std::vector<SampleType> area;
+        if (area.size() < 2 * M)
+        {
+            area.resize(2 * M);
+        }
+        return area.data();
+    }
+}
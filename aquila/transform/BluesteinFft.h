@@ -0,0 +1,83 @@
+/**
+ * @file BluesteinFft.h
+ *
+ * Bluestein's (chirp z-transform) FFT algorithm for any length.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#ifndef BLUESTEINFFT_H
+#define BLUESTEINFFT_H
+
+#include "Fft.h"
+#include <memory>
+#include <vector>
+
+namespace Aquila
+{
+    /**
+     * Bluestein's (chirp z-transform) FFT algorithm for any length.
+     *
+     * Using nk = (n^2 + k^2 - (k-n)^2) / 2, the DFT is rewritten as
+     * a convolution with a chirp signal, which is then calculated with
+     * power of 2 FFTs of length M >= 2N-1. This keeps O(N log N)
+     * complexity for lengths with large prime factors.
+     *
+     * The power of 2 transforms come from FftFactory. As they work on
+     * real signals, each complex transform is split into transforms of
+     * its real and imaginary parts.
+     */
+    class AQUILA_EXPORT BluesteinFft : public Fft
+    {
+    public:
+        BluesteinFft(std::size_t length);
+
+        using Fft::fft;
+        using Fft::ifft;
+        using Fft::rfft;
+        using Fft::irfft;
+
+        virtual void fft(const SampleType x[], ComplexType spectrum[]) const;
+        virtual void ifft(const ComplexType spectrum[], SampleType x[]) const;
+        virtual void rfft(const SampleType x[], ComplexType spectrum[]) const;
+        virtual void irfft(const ComplexType spectrum[], SampleType x[]) const;
+
+    private:
+        void cfft(const ComplexType x[], ComplexType spectrum[],
+                  ComplexType work[], SampleType realWork[]) const;
+
+        ComplexType* workArea() const;
+        SampleType* realWorkArea() const;
+
+        /**
+         * Length of the convolution.
+         */
+        const std::size_t M;
+
+        /**
+         * Power of 2 transform used for the convolution.
+         */
+        std::shared_ptr<const Fft> convolutionFft;
+
+        /**
+         * The chirp exp(-j*pi*n^2/N), n = 0 .. N-1.
+         */
+        std::vector<ComplexType> chirp;
+
+        /**
+         * Spectrum of the conjugated chirp.
+         */
+        std::vector<ComplexType> chirpSpectrum;
+    };
+}
+
+#endif // BLUESTEINFFT_H
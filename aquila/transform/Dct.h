@@ -19,8 +19,10 @@
 #define DCT_H
 
 #include "../global.h"
+#include "DctPlan.h"
 #include <cstddef>
 #include <map>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -28,6 +30,10 @@ namespace Aquila
 {
     /**
      * An implementation of the Discrete Cosine Transform.
+     *
+     * Keeps a DctPlan for every pair of input and output lengths it was
+     * called with. Use DctPlan directly to share a transform between
+     * threads.
      */
     class AQUILA_EXPORT Dct
     {
@@ -40,14 +46,6 @@ namespace Aquila
         {
         }
 
-        /**
-         * Destroys the transform object.
-         */
-        ~Dct()
-        {
-            clearCosineCache();
-        }
-
         std::vector<double> dct(const std::vector<double>& data, std::size_t outputLength);
 
     private:
@@ -59,16 +57,14 @@ namespace Aquila
         /**
          * Cache type.
          */
-        typedef std::map<cosineCacheKeyType, double**> cosineCacheType;
+        typedef std::map<cosineCacheKeyType, std::shared_ptr<const DctPlan>> cosineCacheType;
 
         /**
          * Cache object, implemented as a map.
          */
         cosineCacheType cosineCache;
 
-        double** getCachedCosines(std::size_t inputLength, std::size_t outputLength);
-
-        void clearCosineCache();
+        const DctPlan& getCachedPlan(std::size_t inputLength, std::size_t outputLength);
     };
 }
 
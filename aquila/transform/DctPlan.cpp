@@ -0,0 +1,211 @@
+/**
+ * @file DctPlan.cpp
+ *
+ * Precomputed Discrete Cosine Transform (DCT-II) of a fixed size.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#include "DctPlan.h"
+#include "FftFactory.h"
+#include "MixedRadixFft.h"
+#include "../simd.h"
+#include <cmath>
+#include <cstdint>
+
+namespace Aquila
+{
+    namespace
+    {
+        /**
+         * Alignment of the cosine table rows, in doubles (32 bytes).
+         */
+        const std::size_t TABLE_ALIGNMENT = 4;
+
+        /**
+         * Above this many coefficients the FFT method is used by default.
+         */
+        const std::size_t MAX_MATRIX_OUTPUT_LENGTH = 32;
+    }
+
+    /**
+     * Precomputes the tables for a given transform size.
+     *
+     * The default method is the matrix product for up to 32 coefficients
+     * and the FFT for more, unless the input length would need
+     * Bluestein's algorithm. Coefficients beyond the input length are
+     * always calculated with the matrix product.
+     *
+     * @param inputLength number of input values
+     * @param outputLength how many coefficients to calculate
+     * @param method calculation method
+     */
+    DctPlan::DctPlan(std::size_t inputLength, std::size_t outputLength,
+                     Method method):
+        m_inputLength(inputLength), m_outputLength(outputLength),
+        m_method(method), m_stride(0), m_storage(), m_offset(0), m_fft()
+    {
+        if (DefaultMethod == m_method)
+        {
+            bool fftPays = m_outputLength > MAX_MATRIX_OUTPUT_LENGTH &&
+                MixedRadixFft::isSupportedLength(m_inputLength);
+            m_method = fftPays ? FftMethod : MatrixMethod;
+        }
+        if (m_outputLength > m_inputLength)
+        {
+            m_method = MatrixMethod;
+        }
+
+        // DCT scaling factors
+        const double c0 = std::sqrt(1.0 / m_inputLength);
+        const double cn = std::sqrt(2.0 / m_inputLength);
+
+        std::size_t tableSize = 0;
+        if (MatrixMethod == m_method)
+        {
+            m_stride = (m_inputLength + TABLE_ALIGNMENT - 1) /
+                TABLE_ALIGNMENT * TABLE_ALIGNMENT;
+            tableSize = m_outputLength * m_stride;
+        }
+        else
+        {
+            tableSize = 2 * m_outputLength;
+            m_fft = FftFactory::getFft(m_inputLength);
+        }
+        m_storage.resize(tableSize + TABLE_ALIGNMENT - 1, 0.0);
+        const std::uintptr_t address =
+            reinterpret_cast<std::uintptr_t>(m_storage.data());
+        const std::size_t alignment = TABLE_ALIGNMENT * sizeof(double);
+        m_offset = ((alignment - address % alignment) % alignment) /
+            sizeof(double);
+        double* table = m_storage.data() + m_offset;
+
+        if (MatrixMethod == m_method)
+        {
+            for (std::size_t n = 0; n < m_outputLength; ++n)
+            {
+                const double scale = (0 == n) ? c0 : cn;
+                for (std::size_t k = 0; k < m_inputLength; ++k)
+                {
+                    // from the definition of DCT-II
+                    table[n * m_stride + k] = scale *
+                        std::cos((M_PI * (2 * k + 1) * n) /
+                                 (2.0 * m_inputLength));
+                }
+            }
+        }
+        else
+        {
+            // scaled real and imaginary part of exp(j*pi*k/2N)
+            for (std::size_t k = 0; k < m_outputLength; ++k)
+            {
+                const double scale = (0 == k) ? c0 : cn;
+                const double phase = M_PI * k / (2.0 * m_inputLength);
+                table[k] = scale * std::cos(phase);
+                table[m_outputLength + k] = scale * std::sin(phase);
+            }
+        }
+    }
+
+    /**
+     * Calculates the DCT-II coefficients.
+     *
+     * @param input getInputLength() input values
+     * @param output room for getOutputLength() coefficients
+     */
+    void DctPlan::dct(const double input[], double output[]) const
+    {
+        if (MatrixMethod == m_method)
+        {
+            matrixDct(input, output);
+        }
+        else
+        {
+            fftDct(input, output);
+        }
+    }
+
+    /**
+     * Calculates the DCT-II coefficients.
+     *
+     * @param data input data vector of getInputLength() values
+     * @return vector of getOutputLength() DCT coefficients
+     */
+    std::vector<double> DctPlan::dct(const std::vector<double>& data) const
+    {
+        std::vector<double> output(m_outputLength);
+        dct(data.data(), output.data());
+        return output;
+    }
+
+    /**
+     * Multiplies the input by the table of scaled cosines.
+     *
+     * @param input input values
+     * @param output output coefficients
+     */
+    void DctPlan::matrixDct(const double input[], double output[]) const
+    {
+        const double* table = m_storage.data() + m_offset;
+        for (std::size_t n = 0; n < m_outputLength; ++n)
+        {
+            output[n] = dotProduct(table + n * m_stride, input, m_inputLength);
+        }
+    }
+
+    /**
+     * Calculates the DCT-II using an N-point FFT.
+     *
+     * Even-indexed values are placed at the beginning of the work area
+     * and odd-indexed values, reversed, at its end. With V being the FFT
+     * of such sequence, the k-th coefficient is Re(exp(-j*pi*k/2N) * V[k]).
+     *
+     * @param input input values
+     * @param output output coefficients
+     */
+    void DctPlan::fftDct(const double input[], double output[]) const
+    {
+        const std::size_t N = m_inputLength;
+        thread_local std::vector<SampleType> reordered;
+        thread_local std::vector<ComplexType> spectrum;
+        if (reordered.size() < N)
+        {
+            reordered.resize(N);
+        }
+        if (spectrum.size() < N / 2 + 1)
+        {
+            spectrum.resize(N / 2 + 1);
+        }
+
+        for (std::size_t n = 0; 2 * n < N; ++n)
+        {
+            reordered[n] = input[2 * n];
+        }
+        for (std::size_t n = 0; 2 * n + 1 < N; ++n)
+        {
+            reordered[N - 1 - n] = input[2 * n + 1];
+        }
+        m_fft->rfft(reordered.data(), spectrum.data());
+
+        const double* wr = m_storage.data() + m_offset;
+        const double* wi = wr + m_outputLength;
+        for (std::size_t k = 0; k < m_outputLength; ++k)
+        {
+            // bins above N/2 are conjugates of the lower ones
+            const bool upper = k > N / 2;
+            const ComplexType& bin = spectrum[upper ? N - k : k];
+            const double re = bin.real();
+            const double im = upper ? -bin.imag() : bin.imag();
+            output[k] = wr[k] * re + wi[k] * im;
+        }
+    }
+}
@@ -0,0 +1,132 @@
+/**
+ * @file DctPlan.h
+ *
+ * Precomputed Discrete Cosine Transform (DCT-II) of a fixed size.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#ifndef DCTPLAN_H
+#define DCTPLAN_H
+
+#include "../global.h"
+#include "Fft.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Aquila
+{
+    /**
+     * Precomputed Discrete Cosine Transform (DCT-II) of a fixed size.
+     *
+     * The plan calculates first outputLength coefficients of the
+     * orthonormal DCT-II of inputLength values, just as Dct::dct() does.
+     *
+     * When only a few coefficients are needed (which is the case for
+     * MFCC), the plan multiplies the input by a table of scaled cosines,
+     * stored row by row in one contiguous, aligned buffer. Many output
+     * coefficients are calculated from an N-point FFT of the reordered
+     * input instead (Makhoul's algorithm), in O(N log N) time.
+     *
+     * The plan is immutable after construction and its transform
+     * methods are const, so a single plan can be shared by many threads.
+     * Plans are not copyable, as the tables are aligned in place.
+     */
+    class AQUILA_EXPORT DctPlan
+    {
+    public:
+        /**
+         * How the coefficients are calculated.
+         */
+        enum Method {DefaultMethod, MatrixMethod, FftMethod};
+
+        DctPlan(std::size_t inputLength, std::size_t outputLength,
+                Method method = DefaultMethod);
+        DctPlan(const DctPlan&) = delete;
+        DctPlan& operator=(const DctPlan&) = delete;
+
+        void dct(const double input[], double output[]) const;
+        std::vector<double> dct(const std::vector<double>& data) const;
+
+        /**
+         * Returns the number of input values.
+         *
+         * @return input length
+         */
+        std::size_t getInputLength() const
+        {
+            return m_inputLength;
+        }
+
+        /**
+         * Returns the number of calculated coefficients.
+         *
+         * @return output length
+         */
+        std::size_t getOutputLength() const
+        {
+            return m_outputLength;
+        }
+
+        /**
+         * Returns the method chosen for this plan.
+         *
+         * @return MatrixMethod or FftMethod
+         */
+        Method getMethod() const
+        {
+            return m_method;
+        }
+
+    private:
+        void matrixDct(const double input[], double output[]) const;
+        void fftDct(const double input[], double output[]) const;
+
+        /**
+         * Number of input values.
+         */
+        const std::size_t m_inputLength;
+
+        /**
+         * Number of calculated coefficients.
+         */
+        const std::size_t m_outputLength;
+
+        /**
+         * Method used by this plan.
+         */
+        Method m_method;
+
+        /**
+         * Distance between consecutive rows of the cosine table.
+         */
+        std::size_t m_stride;
+
+        /**
+         * Storage of the precomputed tables, with room for alignment.
+         */
+        std::vector<double> m_storage;
+
+        /**
+         * Offset of the first aligned value in the storage.
+         */
+        std::size_t m_offset;
+
+        /**
+         * FFT of the input length, used by the FFT method.
+         */
+        std::shared_ptr<const Fft> m_fft;
+    };
+}
+
+#endif // DCTPLAN_H
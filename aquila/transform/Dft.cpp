@@ -29,30 +29,27 @@ namespace Aquila
     /**
      * Complex unit.
      */
-    const ComplexType Dft::j(0, 1);
+    const std::complex<double> Dft::j(0, 1);
 
     /**
      * Applies the transformation to the signal.
      *
      * @param x input signal
-     * @return calculated spectrum
+     * @param spectrum output spectrum
      */
-    SpectrumType Dft::fft(const SampleType x[])
+    void Dft::fft(const SampleType x[], ComplexType spectrum[]) const
     {
-        SpectrumType spectrum(N);
-        ComplexType WN = std::exp((-j) * 2.0 * M_PI / static_cast<double>(N));
+        std::complex<double> WN = std::exp((-j) * 2.0 * M_PI / static_cast<double>(N));
 
         for (unsigned int k = 0; k < N; ++k)
         {
-            ComplexType sum(0, 0);
+            std::complex<double> sum(0, 0);
             for (unsigned int n = 0; n < N; ++n)
             {
-                sum += x[n] * std::pow(WN, n * k);
+                sum += static_cast<double>(x[n]) * std::pow(WN, n * k);
             }
-            spectrum[k] = sum;
+            spectrum[k] = ComplexType(sum);
         }
-
-        return spectrum;
     }
 
     /**
@@ -61,17 +58,71 @@ namespace Aquila
      * @param spectrum input spectrum
      * @param x output signal
      */
-    void Dft::ifft(SpectrumType spectrum, double x[])
+    void Dft::ifft(const ComplexType spectrum[], SampleType x[]) const
     {
-        ComplexType WN = std::exp((-j) * 2.0 * M_PI / static_cast<double>(N));
+        std::complex<double> WN = std::exp((-j) * 2.0 * M_PI / static_cast<double>(N));
         for (unsigned int k = 0; k < N; ++k)
         {
-            ComplexType sum(0, 0);
+            std::complex<double> sum(0, 0);
+            for (unsigned int n = 0; n < N; ++n)
+            {
+                sum += std::complex<double>(spectrum[n]) * std::pow(WN, -static_cast<int>(n * k));
+            }
+            x[k] = sum.real() / static_cast<double>(N);
+        }
+    }
+
+    /**
+     * Applies the transformation to a real signal.
+     *
+     * Only the first N/2+1 bins are calculated.
+     *
+     * @param x input signal
+     * @param spectrum output half spectrum
+     */
+    void Dft::rfft(const SampleType x[], ComplexType spectrum[]) const
+    {
+        std::complex<double> WN = std::exp((-j) * 2.0 * M_PI / static_cast<double>(N));
+
+        for (unsigned int k = 0; k < N / 2 + 1; ++k)
+        {
+            std::complex<double> sum(0, 0);
             for (unsigned int n = 0; n < N; ++n)
             {
-                sum += spectrum[n] * std::pow(WN, -static_cast<int>(n * k));
+                sum += static_cast<double>(x[n]) * std::pow(WN, n * k);
+            }
+            spectrum[k] = ComplexType(sum);
+        }
+    }
+
+    /**
+     * Applies the inverse transform to a half spectrum.
+     *
+     * Bins above N/2 are conjugates of the given ones, so every pair
+     * of symmetric bins contributes twice their real part.
+     *
+     * @param spectrum first N/2+1 bins of the spectrum
+     * @param x output signal
+     */
+    void Dft::irfft(const ComplexType spectrum[], SampleType x[]) const
+    {
+        std::complex<double> WN = std::exp((-j) * 2.0 * M_PI / static_cast<double>(N));
+        const unsigned int half = static_cast<unsigned int>(N / 2);
+        for (unsigned int k = 0; k < N; ++k)
+        {
+            double sum = spectrum[0].real();
+            for (unsigned int n = 1; n < half; ++n)
+            {
+                sum += 2.0 * std::real(std::complex<double>(spectrum[n]) * std::pow(WN, -static_cast<int>(n * k)));
+            }
+            if (half > 0)
+            {
+                // odd length - Nyquist bin has a conjugate pair as well
+                double factor = (N % 2) ? 2.0 : 1.0;
+                sum += factor * std::real(std::complex<double>(spectrum[half]) *
+                    std::pow(WN, -static_cast<int>(half * k)));
             }
-            x[k] = std::abs(sum) / static_cast<double>(N);
+            x[k] = sum / static_cast<double>(N);
         }
     }
 }
@@ -49,14 +49,23 @@ namespace Aquila
         {
         }
 
-        virtual SpectrumType fft(const SampleType x[]);
-        virtual void ifft(SpectrumType spectrum, double x[]);
+        using Fft::fft;
+        using Fft::ifft;
+        using Fft::rfft;
+        using Fft::irfft;
+
+        virtual void fft(const SampleType x[], ComplexType spectrum[]) const;
+        virtual void ifft(const ComplexType spectrum[], SampleType x[]) const;
+        virtual void rfft(const SampleType x[], ComplexType spectrum[]) const;
+        virtual void irfft(const ComplexType spectrum[], SampleType x[]) const;
 
     private:
         /**
          * Complex unit (0.0 + 1.0j).
+         *
+         * The reference transform always calculates in double precision.
          */
-        static const ComplexType j;
+        static const std::complex<double> j;
     };
 }
 
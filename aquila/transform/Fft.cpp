@@ -0,0 +1,80 @@
+/**
+ * @file Fft.cpp
+ *
+ * An interface for FFT calculation classes.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#include "Fft.h"
+
+namespace Aquila
+{
+    /**
+     * Minimal number of samples in a batch worth splitting between threads.
+     */
+    const std::size_t PARALLEL_BATCH_SAMPLES = 32768;
+
+    /**
+     * Transforms a batch of equally long frames in one call.
+     *
+     * Frames are read from a single buffer, each one starting stride
+     * samples after the previous one (so they may overlap). Spectrum
+     * of i-th frame is written to out + i * N.
+     *
+     * Transforms are const, so a large batch is simply split between
+     * OpenMP threads. Each thread transforms whole frames one at a time;
+     * frames are not interleaved for SIMD, which is used only within
+     * a single transform (by backends which have vector kernels). Twiddle
+     * factors are shared by all frames anyway, and the virtual call per
+     * frame is cheap compared with the transform itself.
+     *
+     * @param base pointer to the first sample of the first frame
+     * @param stride distance between beginnings of consecutive frames
+     * @param count number of frames
+     * @param out output buffer (room for count * N values)
+     */
+    void Fft::fftBatch(const SampleType* base, std::size_t stride,
+                       std::size_t count, ComplexType* out) const
+    {
+        const long frames = static_cast<long>(count);
+        #pragma omp parallel for if(count * N >= PARALLEL_BATCH_SAMPLES)
+        for (long i = 0; i < frames; ++i)
+        {
+            fft(base + i * stride, out + i * N);
+        }
+    }
+
+    /**
+     * Transforms a batch of equally long real frames in one call.
+     *
+     * Works like fftBatch(), but calculates only the N/2+1 non-redundant
+     * bins of each frame. Half spectrum of i-th frame is written to
+     * out + i * (N/2+1).
+     *
+     * @param base pointer to the first sample of the first frame
+     * @param stride distance between beginnings of consecutive frames
+     * @param count number of frames
+     * @param out output buffer (room for count * (N/2+1) values)
+     */
+    void Fft::rfftBatch(const SampleType* base, std::size_t stride,
+                        std::size_t count, ComplexType* out) const
+    {
+        const std::size_t spectrumSize = getRealSpectrumSize();
+        const long frames = static_cast<long>(count);
+        #pragma omp parallel for if(count * N >= PARALLEL_BATCH_SAMPLES)
+        for (long i = 0; i < frames; ++i)
+        {
+            rfft(base + i * stride, out + i * spectrumSize);
+        }
+    }
+}
@@ -38,6 +38,20 @@ namespace Aquila
      * for the base FFT interface. A derived class should calculate the
      * plan once - in the constructor (based on FFT length). Later calls
      * to fft() / ifft() should reuse the already created plan/cache.
+     *
+     * The transform methods are const and must not modify the object,
+     * so a single FFT object can be shared between threads and used
+     * concurrently without locking. Any temporary storage an
+     * implementation needs should be local to the calling thread.
+     *
+     * Derived classes implement only the overloads working on caller's
+     * buffers. The ones returning SpectrumType are convenience wrappers
+     * which allocate the result vector; derived classes should bring
+     * them into scope with a using-declaration.
+     *
+     * Batch methods transform many frames of a long signal in one call,
+     * splitting the frames between threads. The default implementation
+     * loops over frames; backends may override it with a faster one.
      */
     class AQUILA_EXPORT Fft
     {
@@ -67,7 +81,12 @@ namespace Aquila
          * @param x input signal
          * @return calculated spectrum
          */
-        virtual SpectrumType fft(const SampleType x[]) = 0;
+        SpectrumType fft(const SampleType x[]) const
+        {
+            SpectrumType spectrum(N);
+            fft(x, &spectrum[0]);
+            return spectrum;
+        }
 
         /**
          * Applies the inverse FFT transform to the spectrum.
@@ -75,13 +94,110 @@ namespace Aquila
          * @param spectrum input spectrum
          * @param x output signal
          */
-        virtual void ifft(SpectrumType spectrum, double x[]) = 0;
+        void ifft(const SpectrumType& spectrum, SampleType x[]) const
+        {
+            ifft(&spectrum[0], x);
+        }
+
+        /**
+         * Applies the forward FFT transform to a real-valued signal.
+         *
+         * Spectrum of a real signal is conjugate-symmetric, so only the
+         * N/2+1 non-redundant bins (from DC up to the Nyquist frequency)
+         * are calculated and returned.
+         *
+         * @param x input signal
+         * @return first N/2+1 bins of the spectrum
+         */
+        SpectrumType rfft(const SampleType x[]) const
+        {
+            SpectrumType spectrum(getRealSpectrumSize());
+            rfft(x, &spectrum[0]);
+            return spectrum;
+        }
+
+        /**
+         * Applies the inverse FFT transform to a half spectrum.
+         *
+         * The remaining bins are implied by conjugate symmetry, therefore
+         * the output signal is always real.
+         *
+         * @param spectrum first N/2+1 bins of the spectrum
+         * @param x output signal
+         */
+        void irfft(const SpectrumType& spectrum, SampleType x[]) const
+        {
+            irfft(&spectrum[0], x);
+        }
+
+        /**
+         * Applies the forward FFT transform, writing to a caller's buffer.
+         *
+         * This and the following overloads do not allocate any memory,
+         * so they are the ones to use when transforming many frames.
+         *
+         * @param x input signal (N samples)
+         * @param spectrum output spectrum (room for N values)
+         */
+        virtual void fft(const SampleType x[], ComplexType spectrum[]) const = 0;
+
+        /**
+         * Applies the inverse FFT transform, writing to a caller's buffer.
+         *
+         * The output is the real part of the inverse transform; for
+         * spectra of real signals it is the original signal.
+         *
+         * @param spectrum input spectrum (N values)
+         * @param x output signal (room for N samples)
+         */
+        virtual void ifft(const ComplexType spectrum[], SampleType x[]) const = 0;
+
+        /**
+         * Applies the real forward transform, writing to a caller's buffer.
+         *
+         * @param x input signal (N samples)
+         * @param spectrum output half spectrum (room for N/2+1 values)
+         */
+        virtual void rfft(const SampleType x[], ComplexType spectrum[]) const = 0;
+
+        /**
+         * Applies the real inverse transform, writing to a caller's buffer.
+         *
+         * @param spectrum input half spectrum (N/2+1 values)
+         * @param x output signal (room for N samples)
+         */
+        virtual void irfft(const ComplexType spectrum[], SampleType x[]) const = 0;
+
+        virtual void fftBatch(const SampleType* base, std::size_t stride,
+                              std::size_t count, ComplexType* out) const;
+        virtual void rfftBatch(const SampleType* base, std::size_t stride,
+                               std::size_t count, ComplexType* out) const;
+
+        /**
+         * Returns the transform length.
+         *
+         * @return signal and (full) spectrum length
+         */
+        std::size_t getLength() const
+        {
+            return N;
+        }
+
+        /**
+         * Returns the number of bins calculated by rfft().
+         *
+         * @return N/2+1
+         */
+        std::size_t getRealSpectrumSize() const
+        {
+            return N / 2 + 1;
+        }
 
     protected:
         /**
          * Signal and spectrum length.
          */
-        std::size_t N;
+        const std::size_t N;
 
     private:
         Fft( const Fft& );
@@ -16,10 +16,62 @@
  */
 
 #include "FftFactory.h"
+#include "AquilaFft.h"
+#include "../Exceptions.h"
+#include "BluesteinFft.h"
+#include "MixedRadixFft.h"
 #include "OouraFft.h"
+#include "Radix4Fft.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <utility>
+#include <vector>
 
 namespace Aquila
 {
+    namespace
+    {
+        /**
+         * Cached FFT objects, keyed by length and backend.
+         */
+        std::map<std::pair<std::size_t, FftFactory::Backend>,
+                 std::shared_ptr<const Fft>> fftCache;
+
+        /**
+         * Fastest backends found by measurement, keyed by length.
+         */
+        std::map<std::size_t, FftFactory::Backend> fftWisdom;
+
+        /**
+         * Current planning mode.
+         */
+        FftFactory::PlanningMode fftPlanningMode = FftFactory::Estimate;
+
+        /**
+         * Guards access to the cache, wisdom and planning mode.
+         */
+        std::mutex fftCacheMutex;
+
+        /**
+         * All backends that can be measured.
+         */
+        const FftFactory::Backend allBackends[] = {
+            FftFactory::AquilaBackend, FftFactory::OouraBackend,
+            FftFactory::Radix4Backend, FftFactory::MixedRadixBackend,
+            FftFactory::BluesteinBackend
+        };
+
+        /**
+         * Minimal duration of a single timing run, in seconds.
+         */
+        const double MIN_TIMING_DURATION = 0.002;
+    }
+
     /**
      * Returns "the best possible" FFT object.
      *
@@ -30,13 +82,444 @@ namespace Aquila
      * only a pointer to the base abstract Fft class.
      *
      * As of now, the fastest implementation in Aquila is using Ooura's
-     * mathematical packages, so this one is always returned.
+     * mathematical packages, so this one is returned for powers of 2.
+     * Vectorized Radix4Fft is on par with it; use the overload taking
+     * a backend to choose the implementation explicitly.
+     *
+     * Other lengths are handled by MixedRadixFft if they are products of
+     * 2, 3, 5 and 7, or by BluesteinFft otherwise.
+     *
+     * This choice is overridden by wisdom (see getDefaultBackend()).
      *
      * @param length FFT length (number of samples)
      * @return the FFT object (wrapped in a shared_ptr)
      */
-    std::shared_ptr<Fft> FftFactory::getFft(std::size_t length)
+    std::shared_ptr<const Fft> FftFactory::getFft(std::size_t length)
+    {
+        return getFft(length, DefaultBackend);
+    }
+
+    /**
+     * Returns an FFT object using the chosen implementation.
+     *
+     * The object is created on first request and then shared by all
+     * callers asking for the same length and backend. Creation happens
+     * outside of the cache lock, so concurrent first requests may each
+     * create an object, but only one of them is kept and returned.
+     *
+     * @param length FFT length (number of samples)
+     * @param backend FFT implementation
+     * @return the FFT object (wrapped in a shared_ptr)
+     * @throw Aquila::Exception if the backend cannot handle the length
+     */
+    std::shared_ptr<const Fft> FftFactory::getFft(std::size_t length,
+                                                  Backend backend)
+    {
+        if (DefaultBackend == backend)
+        {
+            backend = getDefaultBackend(length);
+        }
+        const auto key = std::make_pair(length, backend);
+
+        {
+            std::lock_guard<std::mutex> lock(fftCacheMutex);
+            auto it = fftCache.find(key);
+            if (it != fftCache.end())
+            {
+                return it->second;
+            }
+        }
+
+        // created without holding the lock, as some backends request
+        // other FFT objects from the factory
+        std::shared_ptr<const Fft> fft(createFft(length, backend));
+
+        std::lock_guard<std::mutex> lock(fftCacheMutex);
+        // another thread may have created the same object meanwhile
+        auto inserted = fftCache.insert(std::make_pair(key, fft));
+        return inserted.first->second;
+    }
+
+    /**
+     * Releases all cached FFT objects.
+     *
+     * Objects still held by callers remain valid; they will be destroyed
+     * when the last reference goes away.
+     */
+    void FftFactory::clearCache()
+    {
+        std::lock_guard<std::mutex> lock(fftCacheMutex);
+        fftCache.clear();
+    }
+
+    /**
+     * Sets the way of choosing backends for lengths without wisdom.
+     *
+     * In Estimate mode (the default) a fixed rule is used. In Measure
+     * mode the first request for a given length times all suitable
+     * backends, which takes a few milliseconds per backend.
+     *
+     * @param mode planning mode
+     */
+    void FftFactory::setPlanningMode(PlanningMode mode)
+    {
+        std::lock_guard<std::mutex> lock(fftCacheMutex);
+        fftPlanningMode = mode;
+    }
+
+    /**
+     * Returns the current planning mode.
+     *
+     * @return planning mode
+     */
+    FftFactory::PlanningMode FftFactory::getPlanningMode()
+    {
+        std::lock_guard<std::mutex> lock(fftCacheMutex);
+        return fftPlanningMode;
+    }
+
+    /**
+     * Returns the backend used by getFft(length).
+     *
+     * Wisdom, if available for the length, always wins. Otherwise the
+     * backend is measured or estimated, depending on the planning mode.
+     *
+     * @param length FFT length (number of samples)
+     * @return FFT implementation
+     */
+    FftFactory::Backend FftFactory::getDefaultBackend(std::size_t length)
+    {
+        PlanningMode mode = Estimate;
+        {
+            std::lock_guard<std::mutex> lock(fftCacheMutex);
+            auto it = fftWisdom.find(length);
+            if (it != fftWisdom.end() && isSupportedLength(length, it->second))
+            {
+                return it->second;
+            }
+            mode = fftPlanningMode;
+        }
+        return (Measure == mode) ? measure(length) : estimate(length);
+    }
+
+    /**
+     * Times all backends able to handle the length and picks the fastest.
+     *
+     * The result is stored as wisdom for this length, replacing any
+     * previous one.
+     *
+     * @param length FFT length (number of samples)
+     * @return the fastest FFT implementation
+     */
+    FftFactory::Backend FftFactory::measure(std::size_t length)
+    {
+        if (length < 2)
+        {
+            return estimate(length);
+        }
+
+        Backend best = estimate(length);
+        double bestTime = 0.0;
+        for (Backend backend : allBackends)
+        {
+            if (!isSupportedLength(length, backend))
+            {
+                continue;
+            }
+            std::unique_ptr<Fft> fft(createFft(length, backend));
+            const double time = timeTransform(*fft);
+            if (bestTime == 0.0 || time < bestTime)
+            {
+                best = backend;
+                bestTime = time;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(fftCacheMutex);
+        fftWisdom[length] = best;
+        return best;
+    }
+
+    /**
+     * Loads wisdom from a file, adding to the wisdom already known.
+     *
+     * The file is a plain text list of "length backend" lines, as written
+     * by saveWisdom(); lines starting with # are comments. Measurements
+     * are valid only for the instruction set they were made with, so
+     * entries are used only if they follow a "kernel name" line matching
+     * getKernelName(). Entries measured elsewhere (or in files without
+     * a kernel line) and entries with lengths their backend cannot
+     * handle are ignored.
+     *
+     * @param filename wisdom file name
+     * @throw Aquila::Exception if the file cannot be opened
+     * @throw Aquila::FormatException if the file is malformed
+     */
+    void FftFactory::loadWisdom(const std::string& filename)
+    {
+        std::ifstream fs(filename.c_str());
+        if (!fs)
+        {
+            throw Exception("Cannot open FFT wisdom file: " + filename);
+        }
+
+        std::map<std::size_t, Backend> wisdom;
+        bool kernelMatches = false;
+        std::string line;
+        while (std::getline(fs, line))
+        {
+            if (line.empty() || '#' == line[0])
+            {
+                continue;
+            }
+            std::istringstream ls(line);
+            if (0 == line.compare(0, 7, "kernel "))
+            {
+                std::string kernel;
+                ls.ignore(7);
+                if (!(ls >> kernel))
+                {
+                    throw FormatException("Malformed FFT wisdom line: " + line);
+                }
+                kernelMatches = kernel == getKernelName();
+                continue;
+            }
+            std::size_t length = 0;
+            std::string name;
+            if (!(ls >> length >> name))
+            {
+                throw FormatException("Malformed FFT wisdom line: " + line);
+            }
+            auto backend = std::find_if(
+                std::begin(allBackends), std::end(allBackends),
+                [&name] (Backend b) { return name == getBackendName(b); }
+            );
+            if (backend == std::end(allBackends))
+            {
+                throw FormatException("Unknown FFT backend: " + name);
+            }
+            if (kernelMatches && isSupportedLength(length, *backend))
+            {
+                wisdom[length] = *backend;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(fftCacheMutex);
+        for (auto it = wisdom.begin(); it != wisdom.end(); ++it)
+        {
+            fftWisdom[it->first] = it->second;
+        }
+    }
+
+    /**
+     * Saves all known wisdom to a file.
+     *
+     * @param filename wisdom file name
+     * @throw Aquila::Exception if the file cannot be written
+     */
+    void FftFactory::saveWisdom(const std::string& filename)
+    {
+        std::map<std::size_t, Backend> wisdom;
+        {
+            std::lock_guard<std::mutex> lock(fftCacheMutex);
+            wisdom = fftWisdom;
+        }
+
+        std::ofstream fs(filename.c_str());
+        fs << "# Aquila FFT wisdom: length backend\n";
+        fs << "kernel " << getKernelName() << "\n";
+        for (auto it = wisdom.begin(); it != wisdom.end(); ++it)
+        {
+            fs << it->first << " " << getBackendName(it->second) << "\n";
+        }
+        if (!fs)
+        {
+            throw Exception("Cannot write FFT wisdom file: " + filename);
+        }
+    }
+
+    /**
+     * Forgets all wisdom.
+     */
+    void FftFactory::clearWisdom()
+    {
+        std::lock_guard<std::mutex> lock(fftCacheMutex);
+        fftWisdom.clear();
+    }
+
+    /**
+     * Returns the name of instruction set the wisdom is valid for.
+     *
+     * This is the kernel chosen by Radix4Fft for this processor; the
+     * other backends do not depend on it.
+     *
+     * @return "avx2", "sse2", "neon" or "scalar"
+     */
+    std::string FftFactory::getKernelName()
+    {
+        static const std::string kernelName = Radix4Fft(4).getKernelName();
+        return kernelName;
+    }
+
+    /**
+     * Returns a short name of the backend, as used in wisdom files.
+     *
+     * @param backend FFT implementation
+     * @return backend name
+     */
+    const char* FftFactory::getBackendName(Backend backend)
+    {
+        switch (backend)
+        {
+        case AquilaBackend:
+            return "aquila";
+        case OouraBackend:
+            return "ooura";
+        case Radix4Backend:
+            return "radix4";
+        case MixedRadixBackend:
+            return "mixedradix";
+        case BluesteinBackend:
+            return "bluestein";
+        case DefaultBackend:
+        default:
+            return "default";
+        }
+    }
+
+    /**
+     * Checks whether the backend can transform signals of given length.
+     *
+     * Aquila, Ooura and Radix4 backends need powers of 2, MixedRadix
+     * needs products of 2, 3, 5 and 7, and Bluestein handles any length.
+     * No backend handles zero length.
+     *
+     * @param length FFT length (number of samples)
+     * @param backend FFT implementation (DefaultBackend picks a suitable one)
+     * @return true if the length is supported
+     */
+    bool FftFactory::isSupportedLength(std::size_t length, Backend backend)
+    {
+        if (0 == length)
+        {
+            return false;
+        }
+        switch (backend)
+        {
+        case AquilaBackend:
+        case OouraBackend:
+        case Radix4Backend:
+            return (length & (length - 1)) == 0;
+        case MixedRadixBackend:
+            return MixedRadixFft::isSupportedLength(length);
+        case BluesteinBackend:
+        case DefaultBackend:
+        default:
+            return true;
+        }
+    }
+
+    /**
+     * Chooses the backend for a given length with a fixed rule.
+     *
+     * @param length FFT length (number of samples)
+     * @return FFT implementation
+     * @throw Aquila::Exception if length is zero
+     */
+    FftFactory::Backend FftFactory::estimate(std::size_t length)
+    {
+        if (0 == length)
+        {
+            throw Exception("FFT length must be positive");
+        }
+        if ((length & (length - 1)) == 0)
+        {
+            return OouraBackend;
+        }
+        if (MixedRadixFft::isSupportedLength(length))
+        {
+            return MixedRadixBackend;
+        }
+        return BluesteinBackend;
+    }
+
+    /**
+     * Measures the time of a single real transform.
+     *
+     * The transform is repeated until a run lasts long enough to be
+     * timed reliably; the best of three such runs is used.
+     *
+     * @param fft FFT object
+     * @return time of one transform in seconds
+     */
+    double FftFactory::timeTransform(const Fft& fft)
+    {
+        typedef std::chrono::steady_clock Clock;
+
+        const std::size_t N = fft.getLength();
+        std::vector<SampleType> x(N);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            x[i] = std::sin(0.1 * i) + 0.001 * (i % 17);
+        }
+        std::vector<ComplexType> spectrum(fft.getRealSpectrumSize());
+        fft.rfft(&x[0], &spectrum[0]);
+
+        std::size_t repetitions = 1;
+        double best = 0.0;
+        for (int run = 0; run < 3; )
+        {
+            const Clock::time_point start = Clock::now();
+            for (std::size_t r = 0; r < repetitions; ++r)
+            {
+                fft.rfft(&x[0], &spectrum[0]);
+            }
+            const double duration = std::chrono::duration<double>(
+                Clock::now() - start).count();
+            if (duration < MIN_TIMING_DURATION)
+            {
+                repetitions *= 2;
+                continue;
+            }
+            const double time = duration / repetitions;
+            if (0 == run || time < best)
+            {
+                best = time;
+            }
+            ++run;
+        }
+        return best;
+    }
+
+    /**
+     * Creates a new FFT object.
+     *
+     * @param length FFT length (number of samples)
+     * @param backend FFT implementation
+     * @return the FFT object
+     * @throw Aquila::Exception if the backend cannot handle the length
+     */
+    Fft* FftFactory::createFft(std::size_t length, Backend backend)
     {
-        return std::shared_ptr<Fft>(new OouraFft(length));
+        if (!isSupportedLength(length, backend))
+        {
+            throw Exception(std::string("Unsupported FFT length for ") +
+                            getBackendName(backend) + " backend");
+        }
+        switch (backend)
+        {
+        case AquilaBackend:
+            return new AquilaFft(length);
+        case Radix4Backend:
+            return new Radix4Fft(length);
+        case MixedRadixBackend:
+            return new MixedRadixFft(length);
+        case BluesteinBackend:
+            return new BluesteinFft(length);
+        case OouraBackend:
+        case DefaultBackend:
+        default:
+            return new OouraFft(length);
+        }
     }
 }
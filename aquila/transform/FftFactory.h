@@ -22,16 +22,61 @@
 #include "Fft.h"
 #include <cstddef>
 #include <memory>
+#include <string>
 
 namespace Aquila
 {
     /**
      * A factory class to manage the creation of FFT calculation objects.
+     *
+     * FFT objects are cached by length and backend, so all callers
+     * asking for the same transform share one plan. The objects are
+     * immutable, and both the factory and the returned transforms can
+     * be used from many threads at once.
+     *
+     * By default the implementation is chosen by a fixed rule. In the
+     * measuring planning mode, all implementations able to handle the
+     * requested length are timed on first request and the fastest one
+     * is remembered. These measurements ("wisdom") can be saved to
+     * a file and loaded by other processes; wisdom measured with another
+     * instruction set (see getKernelName()) is ignored.
      */
     class AQUILA_EXPORT FftFactory
     {
     public:
-        static std::shared_ptr<Fft> getFft(std::size_t length);
+        /**
+         * Available FFT implementations.
+         */
+        enum Backend {DefaultBackend, AquilaBackend, OouraBackend,
+                      Radix4Backend, MixedRadixBackend, BluesteinBackend};
+
+        /**
+         * How the default backend is chosen for lengths without wisdom.
+         */
+        enum PlanningMode {Estimate, Measure};
+
+        static std::shared_ptr<const Fft> getFft(std::size_t length);
+        static std::shared_ptr<const Fft> getFft(std::size_t length,
+                                                 Backend backend);
+        static void clearCache();
+
+        static void setPlanningMode(PlanningMode mode);
+        static PlanningMode getPlanningMode();
+        static Backend measure(std::size_t length);
+        static Backend getDefaultBackend(std::size_t length);
+
+        static void loadWisdom(const std::string& filename);
+        static void saveWisdom(const std::string& filename);
+        static void clearWisdom();
+
+        static std::string getKernelName();
+        static const char* getBackendName(Backend backend);
+        static bool isSupportedLength(std::size_t length, Backend backend);
+
+    private:
+        static Backend estimate(std::size_t length);
+        static double timeTransform(const Fft& fft);
+        static Fft* createFft(std::size_t length, Backend backend);
     };
 }
 
@@ -0,0 +1,169 @@
+/**
+ * @file Istft.cpp
+ *
+ * Inverse short-time Fourier transform (weighted overlap-add).
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#include "Istft.h"
+#include "FftFactory.h"
+#include "../Exceptions.h"
+#include <algorithm>
+
+namespace Aquila
+{
+    namespace
+    {
+        /**
+         * Samples covered by less window energy than this are zeroed.
+         */
+        const double MIN_WINDOW_NORM = 1e-10;
+    }
+
+    /**
+     * Creates the inverse transform and allocates all its buffers.
+     *
+     * @param frameLength number of samples in each frame (FFT length)
+     * @param hopLength distance between consecutive frames in samples
+     * @param window synthesis window type, same as used for analysis
+     * @throw Aquila::Exception if hop length is zero or above frame length
+     */
+    Istft::Istft(std::size_t frameLength, std::size_t hopLength,
+                 Stft::WindowType window):
+        m_frameLength(frameLength), m_hopLength(hopLength),
+        m_window(), m_fft(), m_frame(frameLength),
+        m_samples(frameLength, 0.0), m_norms(frameLength, 0.0), m_frames(0)
+    {
+        if (0 == m_hopLength || m_hopLength > m_frameLength)
+        {
+            throw Exception("ISTFT hop length must be between 1 and frame length");
+        }
+        m_window = Stft::getWindow(window, m_frameLength);
+        m_fft = FftFactory::getFft(m_frameLength);
+    }
+
+    /**
+     * Processes a block of consecutive frames.
+     *
+     * Output samples which are complete after adding these frames are
+     * written out: getHopLength() samples per frame.
+     *
+     * @param spectra frameCount * getBinCount() values, frame by frame
+     * @param frameCount number of frames in the block
+     * @param output room for frameCount * getHopLength() samples
+     * @return number of samples written
+     */
+    std::size_t Istft::process(const ComplexType spectra[],
+                               std::size_t frameCount, SampleType output[])
+    {
+        const std::size_t binCount = getBinCount();
+        for (std::size_t i = 0; i < frameCount; ++i)
+        {
+            addFrame(spectra + i * binCount);
+            emit(m_hopLength, output + i * m_hopLength);
+        }
+        return frameCount * m_hopLength;
+    }
+
+    /**
+     * Writes out the remaining samples at the end of the signal.
+     *
+     * The transform is reset afterwards and can process a new signal.
+     * Nothing is written if no frames were processed.
+     *
+     * @param output room for getFrameLength() - getHopLength() samples
+     * @return number of samples written
+     */
+    std::size_t Istft::flush(SampleType output[])
+    {
+        std::size_t count = 0;
+        if (m_frames > 0)
+        {
+            count = m_frameLength - m_hopLength;
+            emit(count, output);
+        }
+        reset();
+        return count;
+    }
+
+    /**
+     * Forgets all the frames processed so far.
+     */
+    void Istft::reset()
+    {
+        std::fill(m_samples.begin(), m_samples.end(), 0.0);
+        std::fill(m_norms.begin(), m_norms.end(), 0.0);
+        m_frames = 0;
+    }
+
+    /**
+     * Resynthesizes a whole signal.
+     *
+     * Any frames processed before are discarded.
+     *
+     * @param spectra spectra of all frames, as returned by Stft::transform()
+     * @return signal of getSignalLength(frame count) samples
+     */
+    std::vector<SampleType> Istft::inverse(const std::vector<ComplexType>& spectra)
+    {
+        reset();
+        const std::size_t frameCount = spectra.size() / getBinCount();
+        std::vector<SampleType> output(getSignalLength(frameCount));
+        if (frameCount > 0)
+        {
+            std::size_t written = process(spectra.data(), frameCount,
+                                          output.data());
+            flush(output.data() + written);
+        }
+        return output;
+    }
+
+    /**
+     * Overlap-adds a windowed inverse transform of a frame.
+     *
+     * @param spectrum getBinCount() spectrum values
+     */
+    void Istft::addFrame(const ComplexType spectrum[])
+    {
+        m_fft->irfft(spectrum, m_frame.data());
+        const SampleType* window = m_window->data();
+        for (std::size_t n = 0; n < m_frameLength; ++n)
+        {
+            m_samples[n] += window[n] * m_frame[n];
+            m_norms[n] += window[n] * window[n];
+        }
+        ++m_frames;
+    }
+
+    /**
+     * Normalizes and writes out the first samples of the buffer.
+     *
+     * The buffer is then shifted, so that it starts at the first
+     * sample not written yet.
+     *
+     * @param count number of samples to write
+     * @param output room for count samples
+     */
+    void Istft::emit(std::size_t count, SampleType output[])
+    {
+        for (std::size_t n = 0; n < count; ++n)
+        {
+            output[n] = (m_norms[n] > MIN_WINDOW_NORM) ?
+                static_cast<SampleType>(m_samples[n] / m_norms[n]) : 0;
+        }
+        std::copy(m_samples.begin() + count, m_samples.end(), m_samples.begin());
+        std::fill(m_samples.end() - count, m_samples.end(), 0.0);
+        std::copy(m_norms.begin() + count, m_norms.end(), m_norms.begin());
+        std::fill(m_norms.end() - count, m_norms.end(), 0.0);
+    }
+}
@@ -0,0 +1,157 @@
+/**
+ * @file Istft.h
+ *
+ * Inverse short-time Fourier transform (weighted overlap-add).
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#ifndef ISTFT_H
+#define ISTFT_H
+
+#include "../global.h"
+#include "Fft.h"
+#include "Stft.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Aquila
+{
+    /**
+     * Resynthesizes a signal from its short-time spectra.
+     *
+     * This is the inverse of Stft. Each frame's half spectrum goes
+     * through the inverse real FFT, is multiplied by the synthesis
+     * window (the same as the analysis window) and added to the output
+     * at its hop position. Every output sample is then divided by the
+     * sum of squared window values overlapping it, so an unmodified STFT
+     * gives the original signal back, also at the edges and for any
+     * hop length not larger than the frame.
+     *
+     * Frames are processed in blocks of any size and the output is
+     * produced as soon as no later frame can change it: hopLength
+     * samples per frame. Memory use doesn't depend on signal length,
+     * so a long file can be filtered frame by frame without keeping
+     * its spectrogram:
+     *
+     * Stft stft(512, 128);
+     * Istft istft(512, 128);
+     * for (each 128 new samples) {
+     *     stft.transformFrame(last512Samples, spectrum);
+     *     // modify spectrum
+     *     istft.process(spectrum, 1, output);    // writes 128 samples
+     * }
+     * istft.flush(output);                      // writes 384 samples
+     *
+     * The output lags the input by frameLength - hopLength samples.
+     */
+    class AQUILA_EXPORT Istft
+    {
+    public:
+        Istft(std::size_t frameLength, std::size_t hopLength,
+              Stft::WindowType window = Stft::Hann);
+        Istft(const Istft&) = delete;
+        Istft& operator=(const Istft&) = delete;
+
+        std::size_t process(const ComplexType spectra[], std::size_t frameCount,
+                            SampleType output[]);
+        std::size_t flush(SampleType output[]);
+        void reset();
+
+        std::vector<SampleType> inverse(const std::vector<ComplexType>& spectra);
+
+        /**
+         * Returns the number of samples in each frame (FFT length).
+         *
+         * @return frame length
+         */
+        std::size_t getFrameLength() const
+        {
+            return m_frameLength;
+        }
+
+        /**
+         * Returns the distance between consecutive frames.
+         *
+         * @return hop length in samples
+         */
+        std::size_t getHopLength() const
+        {
+            return m_hopLength;
+        }
+
+        /**
+         * Returns the number of bins expected in each frame's spectrum.
+         *
+         * @return frame length / 2 + 1
+         */
+        std::size_t getBinCount() const
+        {
+            return m_frameLength / 2 + 1;
+        }
+
+        /**
+         * Returns the length of a signal resynthesized from given frames.
+         *
+         * @param frameCount number of frames
+         * @return number of samples
+         */
+        std::size_t getSignalLength(std::size_t frameCount) const
+        {
+            return frameCount > 0 ?
+                (frameCount - 1) * m_hopLength + m_frameLength : 0;
+        }
+
+    private:
+        void addFrame(const ComplexType spectrum[]);
+        void emit(std::size_t count, SampleType output[]);
+
+        /**
+         * Frame length.
+         */
+        const std::size_t m_frameLength;
+
+        /**
+         * Distance between frames.
+         */
+        const std::size_t m_hopLength;
+
+        /**
+         * Cached window table.
+         */
+        std::shared_ptr<const std::vector<SampleType>> m_window;
+
+        /**
+         * FFT of the frame length.
+         */
+        std::shared_ptr<const Fft> m_fft;
+
+        /**
+         * Inverse transform of the current frame.
+         */
+        std::vector<SampleType> m_frame;
+
+        /**
+         * Overlap-added samples and squared window sums, starting at
+         * the first sample not yet emitted.
+         */
+        std::vector<double> m_samples, m_norms;
+
+        /**
+         * Number of frames added since the last reset.
+         */
+        std::size_t m_frames;
+    };
+}
+
+#endif // ISTFT_H
@@ -13,7 +13,7 @@ namespace Aquila
             m_lc.push_back(1 + (m_liftC/2)*std::sin(PI*c/m_liftC));
     }
 
-    std::vector<double> Lifter::apply(const std::vector<double>& feat)
+    std::vector<double> Lifter::apply(const std::vector<double>& feat) const
     {
         // check if feat and coeff vector have same dimensions
         std::vector<double> res(feat.size());
@@ -23,4 +23,9 @@ namespace Aquila
         return res;
     }
 
+    void Lifter::apply(const double feat[], double res[]) const
+    {
+        for(std::size_t i = 0; i < m_numCoeffs; i++)
+            res[i] = feat[i] * m_lc[i];
+    }
 }
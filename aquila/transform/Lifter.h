@@ -12,7 +12,8 @@ namespace Aquila
     {
     public:
         Lifter(std::size_t numCoeffs, int liftC);
-        std::vector<double> apply(const std::vector<double>& feat);
+        std::vector<double> apply(const std::vector<double>& feat) const;
+        void apply(const double feat[], double res[]) const;
     private:
         std::size_t m_numCoeffs;
         int m_liftC;
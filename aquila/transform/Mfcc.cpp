@@ -16,16 +16,15 @@
  */
 
 #include "Mfcc.h"
-#include "Dct.h"
+#include "DctPlan.h"
 #include "Lifter.h"
+#include "../source/FramesCollection.h"
 #include "../source/SignalSource.h"
 #include "../filter/MelFilterBank.h"
 
 #include <algorithm>
 #include <cmath>
-#include <iostream>
 #include <numeric>
-#include <opencv2/core/core.hpp>
 
 namespace Aquila
 {
@@ -39,55 +38,261 @@ namespace Aquila
     std::vector<double> Mfcc::calculate(const SignalSource &source,
                                         std::size_t numFeatures)
     {
-        //auto spectrum = m_fft->fft(source.toArray());
+        return calculate(source, Cepstra, numFeatures);
+    }
 
-        cv::Mat inp(cv::Mat::zeros(m_inputSize, 1, CV_64F));
-        const int n = std::min(source.length(), m_inputSize);
-        for(int i = 0; i < n; i++)
-            inp.at<double>(i, 0) = source.toArray()[i];
+    /**
+     * Calculates the output of a given pipeline stage for a source.
+     *
+     * Later stages of the pipeline are not calculated.
+     *
+     * @param source input signal
+     * @param stage last calculated stage
+     * @param numFeatures how many features to calculate (Cepstra only)
+     * @return vector of getStageSize(stage, numFeatures) values
+     */
+    std::vector<double> Mfcc::calculate(const SignalSource &source,
+                                        Stage stage, std::size_t numFeatures)
+    {
+        const FrequencyType sampleFrequency = source.getSampleFrequency();
+        const Aquila::MelFilterBank bank(sampleFrequency, m_inputSize,
+                                         getMelFilterWidth(sampleFrequency),
+                                         m_numFilters);
+        std::unique_ptr<const DctPlan> dct;
+        std::unique_ptr<const Lifter> lifter;
+        if (Cepstra == stage)
+        {
+            dct.reset(new DctPlan(m_numFilters, numFeatures));
+            lifter.reset(new Lifter(numFeatures, m_lifterCoeff));
+        }
 
-        cv::Mat res(std::ceil(m_inputSize/2), 2, CV_64FC1);
-        cv::dft(inp, res, cv::DFT_COMPLEX_OUTPUT);
-        SpectrumType spectrum;
-        for(int i = 0; i < res.rows; i++)
-            spectrum.push_back(std::complex<double>(res.at<double>(i,0), res.at<double>(i,1)));
+        std::vector<double> output(getStageSize(stage, numFeatures));
+        calculateFrame(source.toArray(), source.length(), stage, &bank,
+                       dct.get(), lifter.get(), output.data());
+        return output;
+    }
 
-        std::vector<double> pspec = periodogram(spectrum);
-        double eng = std::accumulate(pspec.begin(), pspec.end(), 0.0);
+    /**
+     * Calculates MFCC features of all frames in a collection.
+     *
+     * @param frames input frames
+     * @param numFeatures how many features to calculate for each frame
+     * @return frames.count() x numFeatures matrix, stored row by row -
+     *         j-th feature of i-th frame is at index i * numFeatures + j
+     */
+    std::vector<double> Mfcc::calculateAll(const FramesCollection& frames,
+                                           std::size_t numFeatures)
+    {
+        return calculateAll(frames, Cepstra, numFeatures);
+    }
 
-        FrequencyType lowF = 0;
-        FrequencyType highF = source.getSampleFrequency()/2;
-        FrequencyType melLowF = Aquila::MelFilter::linearToMel(lowF);
-        FrequencyType melHighF = Aquila::MelFilter::linearToMel(highF);
-        FrequencyType filterWidth = 2*(melHighF - melLowF) / (double)(m_numFilters+1);
+    /**
+     * Calculates the output of a given stage for all frames in a collection.
+     *
+     * All frames must come from the same source and be inputSize
+     * samples long.
+     *
+     * @param frames input frames
+     * @param stage last calculated stage
+     * @param numFeatures how many features to calculate (Cepstra only)
+     * @return frames.count() x getStageSize(stage, numFeatures) matrix,
+     *         stored row by row
+     */
+    std::vector<double> Mfcc::calculateAll(const FramesCollection& frames,
+                                           Stage stage,
+                                           std::size_t numFeatures)
+    {
+        if (frames.count() == 0)
+        {
+            return std::vector<double>();
+        }
+        return calculateAll(frames.views(), frames.begin()->getSampleFrequency(),
+                            stage, numFeatures);
+    }
+
+    /**
+     * Calculates MFCC features of all frames of a signal.
+     *
+     * @param frames views of input frames
+     * @param sampleFrequency sample frequency of the signal
+     * @param numFeatures how many features to calculate for each frame
+     * @return frames.size() x numFeatures matrix, stored row by row
+     */
+    std::vector<double> Mfcc::calculateAll(const FrameViews& frames,
+                                           FrequencyType sampleFrequency,
+                                           std::size_t numFeatures)
+    {
+        return calculateAll(frames, sampleFrequency, Cepstra, numFeatures);
+    }
+
+    /**
+     * Calculates the output of a given stage for all frames of a signal.
+     *
+     * The filter bank, DCT plan and lifter are created once (and only if
+     * the stage needs them) and shared by all frames, which are processed
+     * in parallel. Frames must be inputSize samples long.
+     *
+     * @param frames views of input frames
+     * @param sampleFrequency sample frequency of the signal
+     * @param stage last calculated stage
+     * @param numFeatures how many features to calculate (Cepstra only)
+     * @return frames.size() x getStageSize(stage, numFeatures) matrix,
+     *         stored row by row
+     */
+    std::vector<double> Mfcc::calculateAll(const FrameViews& frames,
+                                           FrequencyType sampleFrequency,
+                                           Stage stage,
+                                           std::size_t numFeatures)
+    {
+        const std::size_t rowSize = getStageSize(stage, numFeatures);
+        std::vector<double> output(frames.size() * rowSize);
+        if (frames.size() == 0)
+        {
+            return output;
+        }
+
+        std::unique_ptr<const MelFilterBank> bank;
+        std::unique_ptr<const DctPlan> dct;
+        std::unique_ptr<const Lifter> lifter;
+        if (stage != PowerSpectrum)
+        {
+            bank.reset(new MelFilterBank(sampleFrequency, m_inputSize,
+                                         getMelFilterWidth(sampleFrequency),
+                                         m_numFilters));
+        }
+        if (Cepstra == stage)
+        {
+            dct.reset(new DctPlan(m_numFilters, numFeatures));
+            lifter.reset(new Lifter(numFeatures, m_lifterCoeff));
+        }
+
+        const long count = static_cast<long>(frames.size());
+        #pragma omp parallel for
+        for (long i = 0; i < count; ++i)
+        {
+            const FrameView frame = frames[i];
+            calculateFrame(frame.data(), frame.size(), stage, bank.get(),
+                           dct.get(), lifter.get(), output.data() + i * rowSize);
+        }
+        return output;
+    }
+
+    /**
+     * Returns the number of values calculated by a stage for each input.
+     *
+     * @param stage pipeline stage
+     * @param numFeatures number of MFCC features
+     * @return inputSize/2 for power spectrum, number of filters for
+     *         (log) Mel energies, numFeatures for cepstra
+     */
+    std::size_t Mfcc::getStageSize(Stage stage, std::size_t numFeatures) const
+    {
+        switch (stage)
+        {
+        case PowerSpectrum:
+            return m_inputSize / 2;
+        case MelEnergies:
+        case LogMelEnergies:
+            return m_numFilters;
+        default:
+            return numFeatures;
+        }
+    }
+
+    /**
+     * Runs the pipeline for a single input using prepared objects.
+     *
+     * Inputs shorter than inputSize are zero-padded. Intermediate
+     * results are kept in per-thread buffers, reused between calls.
+     * Objects not needed by the stage may be null.
+     *
+     * @param samples input signal
+     * @param length number of input samples
+     * @param stage last calculated stage
+     * @param bank Mel filter bank
+     * @param dct DCT plan from filter bank outputs to numFeatures values
+     * @param lifter lifter of numFeatures values
+     * @param output output buffer for getStageSize() values
+     */
+    void Mfcc::calculateFrame(const SampleType samples[], std::size_t length,
+                              Stage stage, const MelFilterBank* bank,
+                              const DctPlan* dct, const Lifter* lifter,
+                              double output[]) const
+    {
+        thread_local std::vector<SampleType> input;
+        thread_local std::vector<ComplexType> spectrum;
+        thread_local std::vector<double> pspecBuffer, energiesBuffer;
 
-        Aquila::MelFilterBank bank(source.getSampleFrequency(), m_inputSize, filterWidth, m_numFilters);
-        auto filterOutput = bank.applyAll(pspec);
+        if (length < m_inputSize)
+        {
+            input.assign(m_inputSize, 0);
+            std::copy(samples, samples + length, input.begin());
+            samples = input.data();
+        }
+        spectrum.resize(m_fft->getRealSpectrumSize());
+        m_fft->rfft(samples, spectrum.data());
 
-        std::transform(filterOutput.begin(), filterOutput.end(), filterOutput.begin(), 
+        const std::size_t pspecSize = m_inputSize / 2;
+        pspecBuffer.resize(pspecSize);
+        double* pspec = (PowerSpectrum == stage) ? output : pspecBuffer.data();
+        periodogram(spectrum.data(), pspec);
+        if (PowerSpectrum == stage)
+        {
+            return;
+        }
+
+        energiesBuffer.resize(bank->size());
+        double* energies = (Cepstra == stage) ? energiesBuffer.data() : output;
+        bank->applyAll(pspec, pspecSize, 1, energies);
+        if (MelEnergies == stage)
+        {
+            return;
+        }
+
+        std::transform(energies, energies + bank->size(), energies,
                       [this](double fv)->double
                       {
                           return fv > 0? std::log(fv) : std::log(m_eps); 
                       }
                      );
+        if (LogMelEnergies == stage)
+        {
+            return;
+        }
 
-        Aquila::Dct dct;
-        std::vector<double> dcted = dct.dct(filterOutput, numFeatures);
-
-        Aquila::Lifter lifter(numFeatures, m_lifterCoeff);
-        std::vector<double> lifted = lifter.apply(dcted);
-        lifted[0] = eng > 0? std::log(eng) : std::log(m_eps);
+        double eng = std::accumulate(pspec, pspec + pspecSize, 0.0);
+        dct->dct(energies, output);
+        lifter->apply(output, output);
+        output[0] = eng > 0? std::log(eng) : std::log(m_eps);
+    }
 
-        return lifted;
+    /**
+     * Returns the width of Mel filters covering the band up to Nyquist.
+     *
+     * @param sampleFrequency sample frequency in Hz
+     * @return filter width in Mel scale
+     */
+    FrequencyType Mfcc::getMelFilterWidth(FrequencyType sampleFrequency) const
+    {
+        FrequencyType lowF = 0;
+        FrequencyType highF = sampleFrequency/2;
+        FrequencyType melLowF = Aquila::MelFilter::linearToMel(lowF);
+        FrequencyType melHighF = Aquila::MelFilter::linearToMel(highF);
+        return 2*(melHighF - melLowF) / (double)(m_numFilters+1);
     }
 
-    std::vector<double> Mfcc::periodogram(const SpectrumType& spectrum)
+    /**
+     * Calculates the power spectrum of an input.
+     *
+     * Only the first inputSize/2 bins are used, the Nyquist bin is skipped.
+     *
+     * @param spectrum half spectrum of the input
+     * @param pspec output power spectrum (room for inputSize/2 values)
+     */
+    void Mfcc::periodogram(const ComplexType spectrum[], double pspec[]) const
     {
-        std::size_t numCoeffs = static_cast<std::size_t>(std::ceil(spectrum.size()/2));
-        std::vector<double> pspec(numCoeffs);
+        std::size_t numCoeffs = m_inputSize / 2;
         for(std::size_t i = 0; i < numCoeffs; i++)
-            pspec[i] = 1/double(m_inputSize) * std::pow(std::abs(spectrum[i]), 2);
-
-        return pspec;
+            pspec[i] = 1/double(m_inputSize) * std::norm(spectrum[i]);
     }
 }
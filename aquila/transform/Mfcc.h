@@ -21,11 +21,17 @@
 #include "../global.h"
 #include "FftFactory.h"
 #include <cstddef>
+#include <memory>
 #include <vector>
 #include <limits>
 
 namespace Aquila
 {
+    class DctPlan;
+    class FramesCollection;
+    class FrameViews;
+    class Lifter;
+    class MelFilterBank;
     class SignalSource;
 
     /**
@@ -51,10 +57,35 @@ namespace Aquila
      *    // do something with the calculated values
      * }
      *
+     * When features of all frames are needed at once, calculateAll() is
+     * much faster, as it prepares the filter bank, DCT and lifter only
+     * once and processes the frames in parallel:
+     *
+     * auto allValues = mfcc.calculateAll(frames);
+     * // features of i-th frame start at allValues[i * 12]
+     *
+     * Outputs of earlier pipeline stages (power spectrum, Mel filter bank
+     * energies and their logarithms) are available as well, without
+     * calculating the later stages:
+     *
+     * auto logMel = mfcc.calculateAll(frames, Mfcc::LogMelEnergies);
+     *
+     * Frames don't have to be stored in a FramesCollection; calculateAll()
+     * accepts FrameViews of the signal as well, together with its sample
+     * frequency:
+     *
+     * FrameViews views(data, FRAME_SIZE);
+     * auto allValues = mfcc.calculateAll(views, data.getSampleFrequency());
+     *
      */
     class AQUILA_EXPORT Mfcc
     {
     public:
+        /**
+         * Stages of the MFCC pipeline, in order of calculation.
+         */
+        enum Stage {PowerSpectrum, MelEnergies, LogMelEnergies, Cepstra};
+
         /**
          * Constructor creates the FFT object to reuse between calculations.
          *
@@ -68,10 +99,34 @@ namespace Aquila
         }
 
         std::vector<double> calculate(const SignalSource& source, std::size_t numFeatures = 12);
+        std::vector<double> calculate(const SignalSource& source, Stage stage,
+                                      std::size_t numFeatures = 12);
+        std::vector<double> calculateAll(const FramesCollection& frames,
+                                         std::size_t numFeatures = 12);
+        std::vector<double> calculateAll(const FramesCollection& frames,
+                                         Stage stage,
+                                         std::size_t numFeatures = 12);
+        std::vector<double> calculateAll(const FrameViews& frames,
+                                         FrequencyType sampleFrequency,
+                                         std::size_t numFeatures = 12);
+        std::vector<double> calculateAll(const FrameViews& frames,
+                                         FrequencyType sampleFrequency,
+                                         Stage stage,
+                                         std::size_t numFeatures = 12);
+
+        std::size_t getStageSize(Stage stage, std::size_t numFeatures = 12) const;
 
     private:
+        friend class StreamingMfcc;
+
+        void calculateFrame(const SampleType samples[], std::size_t length,
+                            Stage stage, const MelFilterBank* bank,
+                            const DctPlan* dct, const Lifter* lifter,
+                            double output[]) const;
+
+        FrequencyType getMelFilterWidth(FrequencyType sampleFrequency) const;
 
-        std::vector<double> periodogram(const SpectrumType& sprectrum);
+        void periodogram(const ComplexType spectrum[], double pspec[]) const;
         /**
          * Number of samples in each processed input.
          */
@@ -83,7 +138,7 @@ namespace Aquila
         /**
          * FFT calculator.
          */
-        std::shared_ptr<Fft> m_fft;
+        std::shared_ptr<const Fft> m_fft;
     };
 }
 
@@ -0,0 +1,569 @@
+/**
+ * @file MixedRadixFft.cpp
+ *
+ * Mixed-radix FFT for lengths being products of 2, 3, 5 and 7.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+
+#include "MixedRadixFft.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Aquila
+{
+    namespace
+    {
+        /**
+         * Multiplies two complex numbers.
+         *
+         * Written out explicitly, as std::complex multiplication checks
+         * for infinities and NaNs, which makes it a function call.
+         *
+         * @param a first factor
+         * @param b second factor
+         * @return product
+         */
+        inline ComplexType multiply(const ComplexType& a, const ComplexType& b)
+        {
+            return ComplexType(a.real() * b.real() - a.imag() * b.imag(),
+                               a.real() * b.imag() + a.imag() * b.real());
+        }
+    }
+
+    /**
+     * Factors the length and prepares the twiddle factors.
+     *
+     * @param length FFT length (a product of 2, 3, 5 and 7)
+     */
+    MixedRadixFft::MixedRadixFft(std::size_t length):
+        Fft(length), factors(factorize(length)), halfFactors(),
+        twiddles(length)
+    {
+        if (N % 2 == 0)
+        {
+            halfFactors = factorize(N / 2);
+        }
+
+        for (std::size_t k = 0; k < N; ++k)
+        {
+            const double phase = -2.0 * M_PI * k / N;
+            twiddles[k] = ComplexType(std::cos(phase), std::sin(phase));
+        }
+    }
+
+    /**
+     * Checks whether the length is a product of 2, 3, 5 and 7 only.
+     *
+     * @param length FFT length
+     * @return true if MixedRadixFft supports the length
+     */
+    bool MixedRadixFft::isSupportedLength(std::size_t length)
+    {
+        if (length == 0)
+        {
+            return false;
+        }
+        const std::size_t radices[] = {2, 3, 5, 7};
+        for (std::size_t radix : radices)
+        {
+            while (length % radix == 0)
+            {
+                length /= radix;
+            }
+        }
+        return length == 1;
+    }
+
+    /**
+     * Splits the length into stages.
+     *
+     * @param length transform length
+     * @return pairs of (radix, remaining length), empty for length 1
+     */
+    std::vector<std::size_t> MixedRadixFft::factorize(std::size_t length)
+    {
+        std::vector<std::size_t> result;
+        const std::size_t radices[] = {4, 2, 3, 5, 7};
+        for (std::size_t radix : radices)
+        {
+            while (length > 1 && length % radix == 0)
+            {
+                length /= radix;
+                result.push_back(radix);
+                result.push_back(length);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Applies the transformation to the signal.
+     *
+     * @param x input signal
+     * @param spectrum output spectrum
+     */
+    void MixedRadixFft::fft(const SampleType x[], ComplexType spectrum[]) const
+    {
+        if (N % 2 == 0)
+        {
+            rfft(x, spectrum);
+            for (std::size_t k = 1; k < N / 2; ++k)
+            {
+                spectrum[N - k] = std::conj(spectrum[k]);
+            }
+            return;
+        }
+
+        ComplexType* in = workArea();
+        std::copy(x, x + N, in);
+        cfft(in, spectrum);
+    }
+
+    /**
+     * Applies the inverse transform to the spectrum.
+     *
+     * Real part of the inverse is the real part of the forward transform
+     * of the conjugated spectrum, divided by N.
+     *
+     * @param spectrum input spectrum
+     * @param x output signal
+     */
+    void MixedRadixFft::ifft(const ComplexType spectrum[], SampleType x[]) const
+    {
+        if (N % 2 == 0)
+        {
+            inverseReal(spectrum, true, x);
+            return;
+        }
+
+        ComplexType* in = workArea();
+        ComplexType* out = in + N;
+        for (std::size_t k = 0; k < N; ++k)
+        {
+            in[k] = std::conj(spectrum[k]);
+        }
+        cfft(in, out);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            x[i] = out[i].real() / N;
+        }
+    }
+
+    /**
+     * Applies the transformation to a real signal.
+     *
+     * For even N, even and odd samples are packed into real and imaginary
+     * parts of an N/2-point complex signal. Its spectrum is split into
+     * spectra of even and odd samples, which are combined as in
+     * a radix-2 stage.
+     *
+     * @param x input signal
+     * @param spectrum output half spectrum
+     */
+    void MixedRadixFft::rfft(const SampleType x[], ComplexType spectrum[]) const
+    {
+        ComplexType* in = workArea();
+        ComplexType* out = in + N;
+        if (N % 2 != 0)
+        {
+            std::copy(x, x + N, in);
+            cfft(in, out);
+            std::copy(out, out + getRealSpectrumSize(), spectrum);
+            return;
+        }
+
+        const std::size_t M = N / 2;
+        for (std::size_t m = 0; m < M; ++m)
+        {
+            in[m] = ComplexType(x[2 * m], x[2 * m + 1]);
+        }
+        halfFft(in, out);
+
+        spectrum[0] = out[0].real() + out[0].imag();
+        spectrum[M] = out[0].real() - out[0].imag();
+        const SampleType half(0.5);
+        for (std::size_t k = 1; k < M; ++k)
+        {
+            const ComplexType Zk = out[k], Zmk = std::conj(out[M - k]);
+            const ComplexType even = half * (Zk + Zmk);
+            // (Zk - Zmk) / 2j
+            const ComplexType diff = Zk - Zmk;
+            const ComplexType odd(half * diff.imag(), -half * diff.real());
+            spectrum[k] = even + multiply(twiddles[k], odd);
+        }
+    }
+
+    /**
+     * Applies the inverse transform to a half spectrum.
+     *
+     * @param spectrum first N/2+1 bins of the spectrum
+     * @param x output signal
+     */
+    void MixedRadixFft::irfft(const ComplexType spectrum[], SampleType x[]) const
+    {
+        if (N % 2 == 0)
+        {
+            inverseReal(spectrum, false, x);
+            return;
+        }
+
+        ComplexType* in = workArea();
+        ComplexType* out = in + N;
+        for (std::size_t k = 0; k <= N / 2; ++k)
+        {
+            in[k] = std::conj(spectrum[k]);
+        }
+        for (std::size_t k = 1; k < N - N / 2; ++k)
+        {
+            in[N - k] = spectrum[k];
+        }
+        cfft(in, out);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            x[i] = out[i].real() / N;
+        }
+    }
+
+    /**
+     * Applies the forward transform to a complex signal.
+     *
+     * The output is not normalized. Input and output must not overlap.
+     * This method uses no work area, so it can be called from other
+     * transforms which build on this one.
+     *
+     * @param x input signal (N values)
+     * @param spectrum output spectrum (room for N values)
+     */
+    void MixedRadixFft::cfft(const ComplexType x[],
+                             ComplexType spectrum[]) const
+    {
+        if (factors.empty())
+        {
+            std::copy(x, x + N, spectrum);
+            return;
+        }
+        transform(spectrum, x, 1, 1, factors.data());
+    }
+
+    /**
+     * Applies the forward transform of length N/2 to a complex signal.
+     *
+     * Twiddle factors of length N/2 are every other one of length N,
+     * so the transform starts with a twiddle step of 2.
+     *
+     * @param x input signal (N/2 values)
+     * @param spectrum output spectrum (room for N/2 values)
+     */
+    void MixedRadixFft::halfFft(const ComplexType x[],
+                                ComplexType spectrum[]) const
+    {
+        if (halfFactors.empty())
+        {
+            std::copy(x, x + N / 2, spectrum);
+            return;
+        }
+        transform(spectrum, x, 2, 1, halfFactors.data());
+    }
+
+    /**
+     * Calculates the real inverse transform for even N.
+     *
+     * Spectra of even and odd samples are recovered from the input and
+     * packed into an N/2-point spectrum, whose inverse holds even samples
+     * in real parts and odd samples in imaginary parts. The inverse is
+     * calculated as the forward transform of the conjugate.
+     *
+     * @param spectrum full spectrum if symmetrize is true, otherwise
+     *                 the first N/2+1 bins
+     * @param symmetrize whether to use the conjugate-symmetric part
+     *                   of a full spectrum
+     * @param x output signal
+     */
+    void MixedRadixFft::inverseReal(const ComplexType spectrum[],
+                                    bool symmetrize, SampleType x[]) const
+    {
+        const std::size_t M = N / 2;
+        const SampleType half(0.5);
+        auto bin = [&] (std::size_t k) -> ComplexType
+        {
+            if (symmetrize)
+            {
+                return half * (spectrum[k] + std::conj(spectrum[(N - k) % N]));
+            }
+            // imaginary parts of DC and Nyquist bins don't contribute
+            // to a real signal
+            if (k == 0 || k == M)
+            {
+                return spectrum[k].real();
+            }
+            return spectrum[k];
+        };
+
+        ComplexType* in = workArea();
+        ComplexType* out = in + N;
+        for (std::size_t k = 0; k < M; ++k)
+        {
+            const ComplexType Xk = bin(k), Xmk = std::conj(bin(M - k));
+            const ComplexType even = half * (Xk + Xmk);
+            const ComplexType odd = multiply(half * (Xk - Xmk),
+                                             std::conj(twiddles[k]));
+            // conjugate of even + j*odd
+            in[k] = ComplexType(even.real() - odd.imag(),
+                                -(even.imag() + odd.real()));
+        }
+        halfFft(in, out);
+
+        for (std::size_t m = 0; m < M; ++m)
+        {
+            x[2 * m] = out[m].real() / M;
+            x[2 * m + 1] = -out[m].imag() / M;
+        }
+    }
+
+    /**
+     * Recursively calculates one decimation-in-time stage.
+     *
+     * The output consists of p transforms of length m (computed first,
+     * one for each residue of the input index mod p) which are then
+     * combined by radix-p butterflies.
+     *
+     * @param out output array (room for p*m values)
+     * @param in input array
+     * @param fstride twiddle factor step
+     * @param istride input stride
+     * @param factor current (radix, remaining length) pair
+     */
+    void MixedRadixFft::transform(ComplexType out[], const ComplexType in[],
+                                  std::size_t fstride, std::size_t istride,
+                                  const std::size_t* factor) const
+    {
+        const std::size_t p = factor[0], m = factor[1];
+        if (m == 1)
+        {
+            for (std::size_t q = 0; q < p; ++q)
+            {
+                out[q] = in[q * istride];
+            }
+        }
+        else
+        {
+            for (std::size_t q = 0; q < p; ++q)
+            {
+                transform(out + q * m, in + q * istride, fstride * p,
+                          istride * p, factor + 2);
+            }
+        }
+
+        switch (p)
+        {
+        case 2:
+            butterfly2(out, fstride, m);
+            break;
+        case 3:
+            butterfly3(out, fstride, m);
+            break;
+        case 4:
+            butterfly4(out, fstride, m);
+            break;
+        case 5:
+            butterfly5(out, fstride, m);
+            break;
+        default:
+            butterflyGeneric(out, fstride, p, m);
+            break;
+        }
+    }
+
+    /**
+     * Combines two transforms of length m.
+     *
+     * @param out data array
+     * @param fstride twiddle factor step
+     * @param m length of combined transforms
+     */
+    void MixedRadixFft::butterfly2(ComplexType out[], std::size_t fstride,
+                                   std::size_t m) const
+    {
+        for (std::size_t u = 0; u < m; ++u)
+        {
+            const ComplexType t = multiply(out[u + m], twiddles[u * fstride]);
+            out[u + m] = out[u] - t;
+            out[u] += t;
+        }
+    }
+
+    /**
+     * Combines three transforms of length m.
+     *
+     * @param out data array
+     * @param fstride twiddle factor step
+     * @param m length of combined transforms
+     */
+    void MixedRadixFft::butterfly3(ComplexType out[], std::size_t fstride,
+                                   std::size_t m) const
+    {
+        // imaginary part of W_3, the real part is -1/2
+        const SampleType w3 = twiddles[fstride * m].imag();
+        const SampleType half(0.5);
+        for (std::size_t u = 0; u < m; ++u)
+        {
+            const ComplexType a = out[u];
+            const ComplexType b = multiply(out[u + m], twiddles[u * fstride]);
+            const ComplexType c = multiply(out[u + 2 * m],
+                                           twiddles[2 * u * fstride]);
+            const ComplexType s = b + c;
+            const ComplexType d = (b - c) * w3;
+            const ComplexType t = a - half * s;
+            out[u] = a + s;
+            out[u + m] = ComplexType(t.real() - d.imag(), t.imag() + d.real());
+            out[u + 2 * m] = ComplexType(t.real() + d.imag(),
+                                         t.imag() - d.real());
+        }
+    }
+
+    /**
+     * Combines four transforms of length m.
+     *
+     * @param out data array
+     * @param fstride twiddle factor step
+     * @param m length of combined transforms
+     */
+    void MixedRadixFft::butterfly4(ComplexType out[], std::size_t fstride,
+                                   std::size_t m) const
+    {
+        for (std::size_t u = 0; u < m; ++u)
+        {
+            const ComplexType a = out[u];
+            const ComplexType b = multiply(out[u + m], twiddles[u * fstride]);
+            const ComplexType c = multiply(out[u + 2 * m],
+                                           twiddles[2 * u * fstride]);
+            const ComplexType d = multiply(out[u + 3 * m],
+                                           twiddles[3 * u * fstride]);
+            const ComplexType t0 = a + c, t1 = a - c, t2 = b + d, t3 = b - d;
+            // multiplication of t3 by -j
+            const ComplexType t3j(t3.imag(), -t3.real());
+            out[u] = t0 + t2;
+            out[u + m] = t1 + t3j;
+            out[u + 2 * m] = t0 - t2;
+            out[u + 3 * m] = t1 - t3j;
+        }
+    }
+
+    /**
+     * Combines five transforms of length m.
+     *
+     * Outputs k and 5-k share sums of symmetric input pairs, so only
+     * real multiplications by cosines and sines of 2pi/5 and 4pi/5
+     * are needed.
+     *
+     * @param out data array
+     * @param fstride twiddle factor step
+     * @param m length of combined transforms
+     */
+    void MixedRadixFft::butterfly5(ComplexType out[], std::size_t fstride,
+                                   std::size_t m) const
+    {
+        const ComplexType ya = twiddles[fstride * m];
+        const ComplexType yb = twiddles[2 * fstride * m];
+        for (std::size_t u = 0; u < m; ++u)
+        {
+            const ComplexType s0 = out[u];
+            const ComplexType s1 = multiply(out[u + m], twiddles[u * fstride]);
+            const ComplexType s2 = multiply(out[u + 2 * m],
+                                            twiddles[2 * u * fstride]);
+            const ComplexType s3 = multiply(out[u + 3 * m],
+                                            twiddles[3 * u * fstride]);
+            const ComplexType s4 = multiply(out[u + 4 * m],
+                                            twiddles[4 * u * fstride]);
+            const ComplexType s7 = s1 + s4, s10 = s1 - s4;
+            const ComplexType s8 = s2 + s3, s9 = s2 - s3;
+
+            out[u] = s0 + s7 + s8;
+
+            const ComplexType s5(
+                s0.real() + s7.real() * ya.real() + s8.real() * yb.real(),
+                s0.imag() + s7.imag() * ya.real() + s8.imag() * yb.real());
+            const ComplexType s6(
+                s10.imag() * ya.imag() + s9.imag() * yb.imag(),
+                -s10.real() * ya.imag() - s9.real() * yb.imag());
+            out[u + m] = s5 - s6;
+            out[u + 4 * m] = s5 + s6;
+
+            const ComplexType s11(
+                s0.real() + s7.real() * yb.real() + s8.real() * ya.real(),
+                s0.imag() + s7.imag() * yb.real() + s8.imag() * ya.real());
+            const ComplexType s12(
+                -s10.imag() * yb.imag() + s9.imag() * ya.imag(),
+                s10.real() * yb.imag() - s9.real() * ya.imag());
+            out[u + 2 * m] = s11 + s12;
+            out[u + 3 * m] = s11 - s12;
+        }
+    }
+
+    /**
+     * Combines p transforms of length m, for small prime p.
+     *
+     * @param out data array
+     * @param fstride twiddle factor step
+     * @param p radix (at most 7)
+     * @param m length of combined transforms
+     */
+    void MixedRadixFft::butterflyGeneric(ComplexType out[], std::size_t fstride,
+                                         std::size_t p, std::size_t m) const
+    {
+        ComplexType t[7];
+        // W_p is W_N^(N/p), and p * pstride == N
+        const std::size_t pstride = fstride * m;
+        const std::size_t period = p * pstride;
+        for (std::size_t u = 0; u < m; ++u)
+        {
+            for (std::size_t q = 0; q < p; ++q)
+            {
+                t[q] = multiply(out[u + q * m], twiddles[q * u * fstride]);
+            }
+            for (std::size_t k = 0; k < p; ++k)
+            {
+                const std::size_t step = k * pstride;
+                ComplexType sum = t[0];
+                std::size_t idx = 0;
+                for (std::size_t q = 1; q < p; ++q)
+                {
+                    // idx is (q * k mod p) * pstride
+                    idx += step;
+                    if (idx >= period)
+                    {
+                        idx -= period;
+                    }
+                    sum += multiply(t[q], twiddles[idx]);
+                }
+                out[u + k * m] = sum;
+            }
+        }
+    }
+
+    /**
+     * Returns the calling thread's work area.
+     *
+     * @return pointer to 2*N complex values
+     */
+    ComplexType* MixedRadixFft::workArea() const
+    {
+        thread_local std::vector<ComplexType> area;
+        if (area.size() < 2 * N)
+        {
+            area.resize(2 * N);
+        }
+        return area.data();
+    }
+}
@@ -0,0 +1,102 @@
+/**
+ * @file MixedRadixFft.h
+ *
+ * Mixed-radix FFT for lengths being products of 2, 3, 5 and 7.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#ifndef MIXEDRADIXFFT_H
+#define MIXEDRADIXFFT_H
+
+#include "Fft.h"
+#include <vector>
+
+namespace Aquila
+{
+    /**
+     * Mixed-radix FFT for lengths being products of 2, 3, 5 and 7.
+     *
+     * The transform is a recursive decimation-in-time Cooley-Tukey
+     * algorithm. Length is factored into radix-4 and radix-2 stages
+     * first, followed by radix-3, 5 and 7 ones. Typical frame lengths,
+     * such as 400 or 480 samples, are therefore calculated in O(N log N)
+     * without padding.
+     *
+     * Real signals of even length are packed into a complex signal of
+     * half the length, so the real transforms (and the full spectrum,
+     * which follows from conjugate symmetry) cost about half of
+     * a complex transform.
+     */
+    class AQUILA_EXPORT MixedRadixFft : public Fft
+    {
+    public:
+        MixedRadixFft(std::size_t length);
+
+        using Fft::fft;
+        using Fft::ifft;
+        using Fft::rfft;
+        using Fft::irfft;
+
+        virtual void fft(const SampleType x[], ComplexType spectrum[]) const;
+        virtual void ifft(const ComplexType spectrum[], SampleType x[]) const;
+        virtual void rfft(const SampleType x[], ComplexType spectrum[]) const;
+        virtual void irfft(const ComplexType spectrum[], SampleType x[]) const;
+
+        void cfft(const ComplexType x[], ComplexType spectrum[]) const;
+
+        static bool isSupportedLength(std::size_t length);
+
+    private:
+        static std::vector<std::size_t> factorize(std::size_t length);
+
+        void halfFft(const ComplexType x[], ComplexType spectrum[]) const;
+
+        void inverseReal(const ComplexType spectrum[], bool symmetrize,
+                         SampleType x[]) const;
+
+        void transform(ComplexType out[], const ComplexType in[],
+                       std::size_t fstride, std::size_t istride,
+                       const std::size_t* factor) const;
+
+        void butterfly2(ComplexType out[], std::size_t fstride,
+                        std::size_t m) const;
+        void butterfly3(ComplexType out[], std::size_t fstride,
+                        std::size_t m) const;
+        void butterfly4(ComplexType out[], std::size_t fstride,
+                        std::size_t m) const;
+        void butterfly5(ComplexType out[], std::size_t fstride,
+                        std::size_t m) const;
+        void butterflyGeneric(ComplexType out[], std::size_t fstride,
+                              std::size_t p, std::size_t m) const;
+
+        ComplexType* workArea() const;
+
+        /**
+         * Pairs of (radix, remaining length) for consecutive stages.
+         */
+        std::vector<std::size_t> factors;
+
+        /**
+         * Stages of the N/2-point transform of packed real signals
+         * (empty for odd N).
+         */
+        std::vector<std::size_t> halfFactors;
+
+        /**
+         * Twiddle factors W_N^k, k = 0 .. N-1.
+         */
+        std::vector<ComplexType> twiddles;
+    };
+}
+
+#endif // MIXEDRADIXFFT_H
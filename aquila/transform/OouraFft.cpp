@@ -19,23 +19,33 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <vector>
 
 namespace Aquila
 {
     /**
      * Initializes the transform for a given input length.
      *
-     * Prepares the work area for Ooura's algorithm.
+     * Prepares the work area for Ooura's algorithm. Both cdft() and rdft()
+     * share the same tables, which are calculated here up front, so that
+     * none of the transforms has to modify them later.
      *
      * @param length input signal size (usually a power of 2)
      */
     OouraFft::OouraFft(std::size_t length):
         Fft(length),
         // according to the description: "length of ip >= 2+sqrt(n)"
-        ip(new int[static_cast<std::size_t>(2 + std::sqrt(static_cast<double>(N)))]),
-        w(new double[N / 2])
+        ipLength(static_cast<std::size_t>(2 + std::sqrt(static_cast<double>(N)))),
+        ip(new int[ipLength]),
+        // N/2 cos/sin values for cdft() and N/4 cosines for rdft()
+        w(new double[N / 2 + N / 4])
     {
         ip[0] = 0;
+        makewt(static_cast<int>(N / 2), ip, w);
+        if (N > 4)
+        {
+            makect(static_cast<int>(N / 4), ip, w + N / 2);
+        }
     }
 
     /**
@@ -50,18 +60,24 @@ namespace Aquila
     /**
      * Applies the transformation to the signal.
      *
+     * Ooura's functions work in place, so the output buffer doubles as
+     * their work area and no temporary storage is needed (except for
+     * the float build, see workArea()).
+     *
      * @param x input signal
-     * @return calculated spectrum
+     * @param spectrum output spectrum
      */
-    SpectrumType OouraFft::fft(const SampleType x[])
+    void OouraFft::fft(const SampleType x[], ComplexType spectrum[]) const
     {
         static_assert(
-            sizeof(ComplexType[2]) == sizeof(double[4]),
-            "complex<double> has the same memory layout as two consecutive doubles"
+            sizeof(ComplexType[2]) == sizeof(SampleType[4]),
+            "complex has the same memory layout as two consecutive reals"
         );
-        // create a temporary storage array and copy input to even elements
-        // of the array (real values), leaving imaginary components at 0
-        double* a = new double[2 * N];
+        // interpret the output as consecutive pairs of reals (re,im),
+        // copy input to even elements (real values), leaving imaginary
+        // components at 0
+        SampleType* out = reinterpret_cast<SampleType*>(spectrum);
+        double* a = workArea(out, 2 * N);
         for (std::size_t i = 0; i < N; ++i)
         {
             a[2 * i] = x[i];
@@ -69,42 +85,189 @@ namespace Aquila
         }
 
         // let's call the C function from Ooura's package
-        cdft(2*N, -1, a, ip, w);
-
-        // convert the array back to complex values and return as vector
-        ComplexType* tmpPtr = reinterpret_cast<ComplexType*>(a);
-        SpectrumType spectrum(tmpPtr, tmpPtr + N);
-        delete [] a;
-
-        return spectrum;
+        cdft(2*N, -1, a, bitReversalArea(), w);
+        storeWorkArea(a, out, 2 * N);
     }
 
     /**
      * Applies the inverse transform to the spectrum.
      *
+     * Real part of the inverse of any spectrum is equal to the inverse of
+     * its conjugate-symmetric part. That part is packed directly into
+     * the output array and transformed with rdft(), which needs only
+     * N doubles instead of 2N.
+     *
      * @param spectrum input spectrum
      * @param x output signal
      */
-    void OouraFft::ifft(SpectrumType spectrum, double x[])
+    void OouraFft::ifft(const ComplexType spectrum[], SampleType x[]) const
     {
-        static_assert(
-            sizeof(ComplexType[2]) == sizeof(double[4]),
-                "complex<double> has the same memory layout as two consecutive doubles"
-        );
-        // interpret the vector as consecutive pairs of doubles (re,im)
-        // and copy to input/output array
-        double* tmpPtr = reinterpret_cast<double*>(&spectrum[0]);
-        double* a = new double[2 * N];
-        std::copy(tmpPtr, tmpPtr + 2 * N, a);
+        if (N < 2)
+        {
+            x[0] = spectrum[0].real();
+            return;
+        }
+
+        double* a = workArea(x, N);
+        a[0] = spectrum[0].real();
+        a[1] = spectrum[N / 2].real();
+        for (std::size_t k = 1; k < N / 2; ++k)
+        {
+            const ComplexType bin = spectrum[k] + std::conj(spectrum[N - k]);
+            a[2 * k] = 0.5 * bin.real();
+            a[2 * k + 1] = -0.5 * bin.imag();
+        }
+
+        inverseReal(a);
+        storeWorkArea(a, x, N);
+    }
+
+    /**
+     * Applies the transformation to a real signal.
+     *
+     * Uses rdft() which is about twice as fast as a complex transform of
+     * the same length. The output buffer (N+2 doubles) is used as the
+     * work area.
+     *
+     * @param x input signal
+     * @param spectrum output half spectrum
+     */
+    void OouraFft::rfft(const SampleType x[], ComplexType spectrum[]) const
+    {
+        if (N < 2)
+        {
+            spectrum[0] = x[0];
+            return;
+        }
+
+        SampleType* out = reinterpret_cast<SampleType*>(spectrum);
+        double* a = workArea(out, N + 2);
+        std::copy(x, x + N, a);
+
+        rdft(N, 1, a, bitReversalArea(), w);
+
+        // rdft() stores the real Nyquist bin in place of the (zero)
+        // imaginary part of DC; it also uses the exp(+j...) kernel,
+        // hence the imaginary parts need to be negated
+        const double nyquist = a[1];
+        a[1] = 0.0;
+        for (std::size_t k = 1; k < N / 2; ++k)
+        {
+            a[2 * k + 1] = -a[2 * k + 1];
+        }
+        a[N] = nyquist;
+        a[N + 1] = 0.0;
+        storeWorkArea(a, out, N + 2);
+    }
+
+    /**
+     * Applies the inverse transform to a half spectrum.
+     *
+     * @param spectrum first N/2+1 bins of the spectrum
+     * @param x output signal
+     */
+    void OouraFft::irfft(const ComplexType spectrum[], SampleType x[]) const
+    {
+        if (N < 2)
+        {
+            x[0] = spectrum[0].real();
+            return;
+        }
+
+        // pack the spectrum in the layout expected by rdft()
+        double* a = workArea(x, N);
+        a[0] = spectrum[0].real();
+        a[1] = spectrum[N / 2].real();
+        for (std::size_t k = 1; k < N / 2; ++k)
+        {
+            a[2 * k] = spectrum[k].real();
+            a[2 * k + 1] = -spectrum[k].imag();
+        }
+
+        inverseReal(a);
+        storeWorkArea(a, x, N);
+    }
 
-        // Ooura's function
-        cdft(2*N, 1, a, ip, w);
+    /**
+     * Runs the inverse rdft() in place and scales the result.
+     *
+     * @param a spectrum packed in rdft() layout, replaced by the signal
+     */
+    void OouraFft::inverseReal(double a[]) const
+    {
+        rdft(N, -1, a, bitReversalArea(), w);
 
-        // copy the data to the double array and scale it
+        const double scale = 2.0 / static_cast<double>(N);
         for (std::size_t i = 0; i < N; ++i)
         {
-            x[i] = a[2 * i] / static_cast<double>(N);
+            a[i] *= scale;
+        }
+    }
+
+    /**
+     * Returns the array of doubles for Ooura's functions to work on.
+     *
+     * Ooura's package works in double precision only. In a double build
+     * this is simply the output buffer; a float build uses a work area
+     * of the current thread, to be copied to the output by
+     * storeWorkArea().
+     *
+     * @param buffer output buffer
+     * @param size number of values
+     * @return work area for Ooura's functions
+     */
+    double* OouraFft::workArea(SampleType buffer[], std::size_t size) const
+    {
+#ifdef AQUILA_USE_FLOAT
+        (void) buffer;
+        thread_local std::vector<double> area;
+        if (area.size() < size)
+        {
+            area.resize(size);
         }
-        delete [] a;
+        return &area[0];
+#else
+        (void) size;
+        return buffer;
+#endif
+    }
+
+    /**
+     * Copies the work area to the output buffer, if they are different.
+     *
+     * @param a work area returned by workArea()
+     * @param buffer output buffer
+     * @param size number of values
+     */
+    void OouraFft::storeWorkArea(const double a[], SampleType buffer[],
+                                 std::size_t size) const
+    {
+        if (a != static_cast<const void*>(buffer))
+        {
+            std::copy(a, a + size, buffer);
+        }
+    }
+
+    /**
+     * Returns a copy of the bit reversal work area for the current thread.
+     *
+     * Apart from the table sizes kept in ip[0] and ip[1], Ooura's functions
+     * use ip as scratch space, overwriting it on every call. Each thread
+     * gets its own copy, so that one transform object can be used
+     * concurrently. The copy is allocated only once per thread.
+     *
+     * @return work area to pass to Ooura's functions
+     */
+    int* OouraFft::bitReversalArea() const
+    {
+        thread_local std::vector<int> area;
+        if (area.size() < ipLength)
+        {
+            area.resize(ipLength);
+        }
+        area[0] = ip[0];
+        area[1] = ip[1];
+
+        return &area[0];
     }
 }
@@ -23,6 +23,8 @@
 extern "C" {
     void cdft(int, int, double *, int *, double *);
     void rdft(int, int, double *, int *, double *);
+    void makewt(int, int *, double *);
+    void makect(int, int *, double *);
 }
 
 namespace Aquila
@@ -36,17 +38,38 @@ namespace Aquila
         OouraFft(std::size_t length);
         ~OouraFft();
 
-        virtual SpectrumType fft(const SampleType x[]);
-        virtual void ifft(SpectrumType spectrum, double x[]);
+        using Fft::fft;
+        using Fft::ifft;
+        using Fft::rfft;
+        using Fft::irfft;
+
+        virtual void fft(const SampleType x[], ComplexType spectrum[]) const;
+        virtual void ifft(const ComplexType spectrum[], SampleType x[]) const;
+        virtual void rfft(const SampleType x[], ComplexType spectrum[]) const;
+        virtual void irfft(const ComplexType spectrum[], SampleType x[]) const;
 
     private:
+        void inverseReal(double a[]) const;
+
+        double* workArea(SampleType buffer[], std::size_t size) const;
+
+        void storeWorkArea(const double a[], SampleType buffer[],
+                           std::size_t size) const;
+
+        int* bitReversalArea() const;
+
+        /**
+         * Length of the bit reversal work area.
+         */
+        std::size_t ipLength;
+
         /**
          * Work area for bit reversal.
          */
         int* ip;
 
         /**
-         * Cos/sin table.
+         * Cos/sin table, followed by the cos table used only by rdft().
          */
         double* w;
     };
@@ -0,0 +1,364 @@
+/**
+ * @file Radix4Fft.cpp
+ *
+ * A vectorized implementation of FFT radix-4 algorithm.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#include "Radix4Fft.h"
+#include "Radix4FftKernel.h"
+#include "../simd.h"
+#include <cmath>
+
+namespace Aquila
+{
+    namespace
+    {
+        /**
+         * Plain C++ operations, one double at a time.
+         */
+        struct ScalarOps
+        {
+            typedef double Vector;
+            static const std::size_t width = 1;
+
+            static Vector load(const double* p) { return *p; }
+            static void store(double* p, Vector v) { *p = v; }
+            static Vector add(Vector a, Vector b) { return a + b; }
+            static Vector sub(Vector a, Vector b) { return a - b; }
+            static Vector mul(Vector a, Vector b) { return a * b; }
+        };
+
+#ifdef AQUILA_HAVE_SSE2
+        /**
+         * Vector operations on two doubles (SSE2).
+         */
+        struct Sse2Ops
+        {
+            typedef __m128d Vector;
+            static const std::size_t width = 2;
+
+            static Vector load(const double* p) { return _mm_loadu_pd(p); }
+            static void store(double* p, Vector v) { _mm_storeu_pd(p, v); }
+            static Vector add(Vector a, Vector b) { return _mm_add_pd(a, b); }
+            static Vector sub(Vector a, Vector b) { return _mm_sub_pd(a, b); }
+            static Vector mul(Vector a, Vector b) { return _mm_mul_pd(a, b); }
+        };
+#endif
+
+#ifdef AQUILA_HAVE_NEON
+        /**
+         * Vector operations on two doubles (NEON).
+         */
+        struct NeonOps
+        {
+            typedef float64x2_t Vector;
+            static const std::size_t width = 2;
+
+            static Vector load(const double* p) { return vld1q_f64(p); }
+            static void store(double* p, Vector v) { vst1q_f64(p, v); }
+            static Vector add(Vector a, Vector b) { return vaddq_f64(a, b); }
+            static Vector sub(Vector a, Vector b) { return vsubq_f64(a, b); }
+            static Vector mul(Vector a, Vector b) { return vmulq_f64(a, b); }
+        };
+#endif
+    }
+
+    /**
+     * Prepares the tables and chooses the butterfly kernel.
+     *
+     * @param length FFT length (a power of 2)
+     */
+    Radix4Fft::Radix4Fft(std::size_t length):
+        Fft(length), M(length / 2), reversed(M), stageTwiddles(),
+        splitTwiddles(2 * (M + 1)), oddStageCount(false),
+        vectorStage(radix4Stage<ScalarOps>), vectorWidth(ScalarOps::width),
+        kernelName("scalar")
+    {
+        unsigned int bits = 0;
+        while ((static_cast<std::size_t>(1) << bits) < M)
+        {
+            ++bits;
+        }
+        for (std::size_t i = 0; i < M; ++i)
+        {
+            std::size_t r = 0;
+            for (unsigned int b = 0; b < bits; ++b)
+            {
+                r |= ((i >> b) & 1) << (bits - 1 - b);
+            }
+            reversed[i] = r;
+        }
+
+        // the first stage is radix-2 if log2(M) is odd, so that
+        // radix-4 stages start from DFTs of length 2 instead of 1
+        oddStageCount = (bits % 2) != 0;
+        for (std::size_t m = oddStageCount ? 2 : 1; m < M; m *= 4)
+        {
+            const double L = static_cast<double>(4 * m);
+            for (unsigned int k = 1; k <= 3; ++k)
+            {
+                for (std::size_t j = 0; j < m; ++j)
+                {
+                    stageTwiddles.push_back(std::cos(2.0 * M_PI * k * j / L));
+                }
+                for (std::size_t j = 0; j < m; ++j)
+                {
+                    stageTwiddles.push_back(-std::sin(2.0 * M_PI * k * j / L));
+                }
+            }
+        }
+
+        for (std::size_t k = 0; k <= M; ++k)
+        {
+            splitTwiddles[k] = std::cos(2.0 * M_PI * k / N);
+            splitTwiddles[M + 1 + k] = -std::sin(2.0 * M_PI * k / N);
+        }
+
+#if defined(AQUILA_HAVE_SSE2)
+        vectorStage = radix4Stage<Sse2Ops>;
+        vectorWidth = Sse2Ops::width;
+        kernelName = "sse2";
+#elif defined(AQUILA_HAVE_NEON)
+        vectorStage = radix4Stage<NeonOps>;
+        vectorWidth = NeonOps::width;
+        kernelName = "neon";
+#endif
+#ifdef AQUILA_HAVE_AVX2
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        {
+            vectorStage = radix4StageAvx2;
+            vectorWidth = 4;
+            kernelName = "avx2";
+        }
+#endif
+    }
+
+    /**
+     * Applies the transformation to the signal.
+     *
+     * @param x input signal
+     * @param spectrum output spectrum
+     */
+    void Radix4Fft::fft(const SampleType x[], ComplexType spectrum[]) const
+    {
+        rfft(x, spectrum);
+        for (std::size_t k = 1; k < M; ++k)
+        {
+            spectrum[N - k] = std::conj(spectrum[k]);
+        }
+    }
+
+    /**
+     * Applies the inverse transform to the spectrum.
+     *
+     * @param spectrum input spectrum
+     * @param x output signal
+     */
+    void Radix4Fft::ifft(const ComplexType spectrum[], SampleType x[]) const
+    {
+        inverseReal(spectrum, true, x);
+    }
+
+    /**
+     * Applies the transformation to a real signal.
+     *
+     * Even and odd samples become real and imaginary parts of an N/2-point
+     * complex signal. Its spectrum is then split into spectra of even and
+     * odd samples, which are combined as in a radix-2 stage.
+     *
+     * @param x input signal
+     * @param spectrum output half spectrum
+     */
+    void Radix4Fft::rfft(const SampleType x[], ComplexType spectrum[]) const
+    {
+        if (M == 0)
+        {
+            spectrum[0] = x[0];
+            return;
+        }
+
+        double* re = workArea();
+        double* im = re + M;
+        for (std::size_t m = 0; m < M; ++m)
+        {
+            re[reversed[m]] = x[2 * m];
+            im[reversed[m]] = x[2 * m + 1];
+        }
+        complexFft(re, im);
+
+        const double* wr = &splitTwiddles[0];
+        const double* wi = wr + M + 1;
+        spectrum[0] = re[0] + im[0];
+        spectrum[M] = re[0] - im[0];
+        for (std::size_t k = 1; k <= M / 2; ++k)
+        {
+            // E = (Z[k] + conj(Z[M-k])) / 2, O = -j(Z[k] - conj(Z[M-k])) / 2
+            const double er = 0.5 * (re[k] + re[M - k]);
+            const double ei = 0.5 * (im[k] - im[M - k]);
+            const double orr = 0.5 * (im[k] + im[M - k]);
+            const double oi = -0.5 * (re[k] - re[M - k]);
+            // X[k] = E + W^k O, X[M-k] = conj(E) + W^(M-k) conj(O)
+            spectrum[k] = ComplexType(er + wr[k] * orr - wi[k] * oi,
+                                      ei + wr[k] * oi + wi[k] * orr);
+            spectrum[M - k] = ComplexType(
+                er + wr[M - k] * orr + wi[M - k] * oi,
+                -ei - wr[M - k] * oi + wi[M - k] * orr);
+        }
+    }
+
+    /**
+     * Applies the inverse transform to a half spectrum.
+     *
+     * @param spectrum first N/2+1 bins of the spectrum
+     * @param x output signal
+     */
+    void Radix4Fft::irfft(const ComplexType spectrum[], SampleType x[]) const
+    {
+        inverseReal(spectrum, false, x);
+    }
+
+    /**
+     * Calculates a complex forward FFT of length N/2, in place.
+     *
+     * @param re real parts of the signal in bit-reversed order
+     * @param im imaginary parts of the signal in bit-reversed order
+     */
+    void Radix4Fft::complexFft(double re[], double im[]) const
+    {
+        std::size_t m = 1;
+        if (oddStageCount)
+        {
+            // radix-2 stage on adjacent pairs
+            for (std::size_t i = 0; i < M; i += 2)
+            {
+                const double r = re[i + 1], s = im[i + 1];
+                re[i + 1] = re[i] - r;
+                im[i + 1] = im[i] - s;
+                re[i] += r;
+                im[i] += s;
+            }
+            m = 2;
+        }
+        const double* twiddles = stageTwiddles.data();
+        if (m == 1 && M >= 4)
+        {
+            // the first radix-4 stage needs no twiddle factors
+            for (std::size_t i = 0; i < M; i += 4)
+            {
+                const double t0r = re[i] + re[i + 1], t0i = im[i] + im[i + 1];
+                const double t1r = re[i] - re[i + 1], t1i = im[i] - im[i + 1];
+                const double t2r = re[i + 2] + re[i + 3];
+                const double t2i = im[i + 2] + im[i + 3];
+                const double t3r = re[i + 2] - re[i + 3];
+                const double t3i = im[i + 2] - im[i + 3];
+                re[i] = t0r + t2r;
+                im[i] = t0i + t2i;
+                re[i + 1] = t1r + t3i;
+                im[i + 1] = t1i - t3r;
+                re[i + 2] = t0r - t2r;
+                im[i + 2] = t0i - t2i;
+                re[i + 3] = t1r - t3i;
+                im[i + 3] = t1i + t3r;
+            }
+            m = 4;
+            twiddles += 6;
+        }
+
+        for (; m < M; m *= 4)
+        {
+            if (m >= vectorWidth)
+            {
+                vectorStage(re, im, M, m, twiddles);
+            }
+            else
+            {
+                radix4Stage<ScalarOps>(re, im, M, m, twiddles);
+            }
+            twiddles += 6 * m;
+        }
+    }
+
+    /**
+     * Calculates a real inverse transform.
+     *
+     * The N/2-point complex spectrum from rfft() is recovered and inverted
+     * using the forward transform of its conjugate.
+     *
+     * @param spectrum input spectrum
+     * @param symmetrize true if spectrum is a full spectrum whose
+     *                   conjugate-symmetric part should be used
+     * @param x output signal
+     */
+    void Radix4Fft::inverseReal(const ComplexType spectrum[], bool symmetrize,
+                                SampleType x[]) const
+    {
+        typedef std::complex<double> Complex;
+        // k-th bin of the conjugate-symmetric part of the spectrum
+        auto bin = [&] (std::size_t k) -> Complex {
+            if (!symmetrize)
+            {
+                return Complex(spectrum[k]);
+            }
+            return 0.5 * (Complex(spectrum[k]) +
+                          std::conj(Complex(spectrum[(N - k) % N])));
+        };
+
+        if (M == 0)
+        {
+            x[0] = spectrum[0].real();
+            return;
+        }
+
+        double* re = workArea();
+        double* im = re + M;
+        const double* wr = &splitTwiddles[0];
+        const double* wi = wr + M + 1;
+        for (std::size_t k = 0; k < M; ++k)
+        {
+            const Complex Xk = bin(k), Xmk = std::conj(bin(M - k));
+            const Complex Ek = 0.5 * (Xk + Xmk);
+            const Complex Ok = 0.5 * (Xk - Xmk) * Complex(wr[k], -wi[k]);
+            // store conj(E + jO), so that a forward FFT can be used
+            re[reversed[k]] = Ek.real() - Ok.imag();
+            im[reversed[k]] = -(Ek.imag() + Ok.real());
+        }
+        complexFft(re, im);
+
+        const double scale = 1.0 / M;
+        for (std::size_t m = 0; m < M; ++m)
+        {
+            x[2 * m] = re[m] * scale;
+            x[2 * m + 1] = -im[m] * scale;
+        }
+    }
+
+    /**
+     * Returns the calling thread's work area for split complex data.
+     *
+     * The area is shared by all transforms used in a thread and grows
+     * only when a longer transform is calculated.
+     *
+     * @return pointer to N doubles
+     */
+    double* Radix4Fft::workArea() const
+    {
+        thread_local std::vector<double> area;
+        if (area.size() < N)
+        {
+            area.resize(N);
+        }
+        return area.data();
+    }
+}
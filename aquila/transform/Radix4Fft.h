@@ -0,0 +1,120 @@
+/**
+ * @file Radix4Fft.h
+ *
+ * A vectorized implementation of FFT radix-4 algorithm.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#ifndef RADIX4FFT_H
+#define RADIX4FFT_H
+
+#include "Fft.h"
+#include <cstddef>
+#include <vector>
+
+namespace Aquila
+{
+    /**
+     * A vectorized implementation of FFT radix-4 algorithm.
+     *
+     * Real input of length N is packed into a complex signal of length N/2,
+     * which is transformed with radix-4 stages (preceded by a single
+     * radix-2 stage when needed) working on split real/imaginary arrays.
+     *
+     * The butterflies use SSE2 or NEON instructions when the library is
+     * built for a platform which has them, and AVX2 when the processor
+     * running the code supports it. The choice is made once, in the
+     * constructor. Length must be a power of 2.
+     */
+    class AQUILA_EXPORT Radix4Fft : public Fft
+    {
+    public:
+        Radix4Fft(std::size_t length);
+
+        using Fft::fft;
+        using Fft::ifft;
+        using Fft::rfft;
+        using Fft::irfft;
+
+        virtual void fft(const SampleType x[], ComplexType spectrum[]) const;
+        virtual void ifft(const ComplexType spectrum[], SampleType x[]) const;
+        virtual void rfft(const SampleType x[], ComplexType spectrum[]) const;
+        virtual void irfft(const ComplexType spectrum[], SampleType x[]) const;
+
+        /**
+         * Returns the name of instruction set used by the butterflies.
+         *
+         * @return "avx2", "sse2", "neon" or "scalar"
+         */
+        const char* getKernelName() const
+        {
+            return kernelName;
+        }
+
+    private:
+        /**
+         * Signature of a single radix-4 stage working on split complex data.
+         */
+        typedef void (*StageFunction)(double* re, double* im, std::size_t n,
+                                      std::size_t m, const double* twiddles);
+
+        void complexFft(double re[], double im[]) const;
+
+        void inverseReal(const ComplexType spectrum[], bool symmetrize,
+                         SampleType x[]) const;
+
+        double* workArea() const;
+
+        /**
+         * Half of the transform length - size of the complex FFT.
+         */
+        const std::size_t M;
+
+        /**
+         * Bit-reversed index for each of M complex samples.
+         */
+        std::vector<std::size_t> reversed;
+
+        /**
+         * Twiddle factors of all radix-4 stages, one after another.
+         */
+        std::vector<double> stageTwiddles;
+
+        /**
+         * Real and imaginary parts of W_N^k, k = 0 .. N/2 (in two halves).
+         */
+        std::vector<double> splitTwiddles;
+
+        /**
+         * Whether log2(N/2) is odd and a radix-2 stage is needed.
+         */
+        bool oddStageCount;
+
+        /**
+         * Vectorized radix-4 stage.
+         */
+        StageFunction vectorStage;
+
+        /**
+         * Number of doubles processed at once by the vectorized stage.
+         */
+        std::size_t vectorWidth;
+
+        /**
+         * Name of the instruction set used by vectorized stage.
+         */
+        const char* kernelName;
+    };
+}
+
+#endif // RADIX4FFT_H
@@ -0,0 +1,59 @@
+/**
+ * @file Radix4FftAvx2.cpp
+ *
+ * AVX2 code path of the radix-4 FFT kernel.
+ *
+ * This file is compiled with AVX2 instructions enabled, but its code is
+ * called only after a runtime check that the processor supports them.
+ * Therefore it must not define anything else than the kernel itself.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#include "Radix4FftKernel.h"
+#include <immintrin.h>
+
+namespace Aquila
+{
+    namespace
+    {
+        /**
+         * Vector operations on four doubles.
+         */
+        struct Avx2Ops
+        {
+            typedef __m256d Vector;
+            static const std::size_t width = 4;
+
+            static Vector load(const double* p) { return _mm256_loadu_pd(p); }
+            static void store(double* p, Vector v) { _mm256_storeu_pd(p, v); }
+            static Vector add(Vector a, Vector b) { return _mm256_add_pd(a, b); }
+            static Vector sub(Vector a, Vector b) { return _mm256_sub_pd(a, b); }
+            static Vector mul(Vector a, Vector b) { return _mm256_mul_pd(a, b); }
+        };
+    }
+
+    /**
+     * Runs one radix-4 stage using AVX2 instructions.
+     *
+     * @param re real parts
+     * @param im imaginary parts
+     * @param n data length
+     * @param m length of the combined DFTs (a multiple of 4)
+     * @param twiddles twiddle factors of this stage
+     */
+    void radix4StageAvx2(double* re, double* im, std::size_t n,
+                         std::size_t m, const double* twiddles)
+    {
+        radix4Stage<Avx2Ops>(re, im, n, m, twiddles);
+    }
+}
@@ -0,0 +1,123 @@
+/**
+ * @file Radix4FftKernel.h
+ *
+ * Vectorizable radix-4 butterfly kernel shared by Radix4Fft code paths.
+ *
+ * This is an internal header, used only by Radix4Fft implementation files.
+ * Each of them instantiates the kernel with its own set of vector
+ * operations (declared in an anonymous namespace, so that instantiations
+ * compiled for different instruction sets never get merged by the linker).
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#ifndef RADIX4FFTKERNEL_H
+#define RADIX4FFTKERNEL_H
+
+#include <cstddef>
+
+namespace Aquila
+{
+    /**
+     * Runs one decimation-in-time radix-4 stage, in place.
+     *
+     * Data are stored in split format - real and imaginary parts in two
+     * separate arrays - so the innermost loop reads consecutive values
+     * and maps directly to vector registers.
+     *
+     * Every block of 4*m values consists of four DFTs of length m, which
+     * came from the samples with indices equal to 0, 2, 1 and 3 (mod 4),
+     * in that order (this is the order left by bit reversal). The stage
+     * combines them into a single DFT of length 4*m.
+     *
+     * The Ops template parameter provides the vector type and arithmetic;
+     * m must be a multiple of Ops::width.
+     *
+     * @param re real parts
+     * @param im imaginary parts
+     * @param n data length
+     * @param m length of the combined DFTs
+     * @param twiddles W^j, W^2j and W^3j (W = exp(-2*pi*i/4m), 0 <= j < m)
+     *                 as six arrays of m values: re, im, re, im, re, im
+     */
+    template <typename Ops>
+    inline void radix4Stage(double* re, double* im, std::size_t n,
+                            std::size_t m, const double* twiddles)
+    {
+        typedef typename Ops::Vector V;
+        const double* w1r = twiddles;
+        const double* w1i = w1r + m;
+        const double* w2r = w1i + m;
+        const double* w2i = w2r + m;
+        const double* w3r = w2i + m;
+        const double* w3i = w3r + m;
+
+        for (std::size_t b = 0; b < n; b += 4 * m)
+        {
+            double* r0 = re + b;
+            double* r1 = r0 + m;
+            double* r2 = r1 + m;
+            double* r3 = r2 + m;
+            double* i0 = im + b;
+            double* i1 = i0 + m;
+            double* i2 = i1 + m;
+            double* i3 = i2 + m;
+
+            for (std::size_t j = 0; j < m; j += Ops::width)
+            {
+                // second block holds samples 2 (mod 4), third - 1 (mod 4)
+                V ar = Ops::load(r0 + j), ai = Ops::load(i0 + j);
+                V xr = Ops::load(r2 + j), xi = Ops::load(i2 + j);
+                V wr = Ops::load(w1r + j), wi = Ops::load(w1i + j);
+                V br = Ops::sub(Ops::mul(xr, wr), Ops::mul(xi, wi));
+                V bi = Ops::add(Ops::mul(xr, wi), Ops::mul(xi, wr));
+
+                xr = Ops::load(r1 + j);
+                xi = Ops::load(i1 + j);
+                wr = Ops::load(w2r + j);
+                wi = Ops::load(w2i + j);
+                V cr = Ops::sub(Ops::mul(xr, wr), Ops::mul(xi, wi));
+                V ci = Ops::add(Ops::mul(xr, wi), Ops::mul(xi, wr));
+
+                xr = Ops::load(r3 + j);
+                xi = Ops::load(i3 + j);
+                wr = Ops::load(w3r + j);
+                wi = Ops::load(w3i + j);
+                V dr = Ops::sub(Ops::mul(xr, wr), Ops::mul(xi, wi));
+                V di = Ops::add(Ops::mul(xr, wi), Ops::mul(xi, wr));
+
+                V t0r = Ops::add(ar, cr), t0i = Ops::add(ai, ci);
+                V t1r = Ops::sub(ar, cr), t1i = Ops::sub(ai, ci);
+                V t2r = Ops::add(br, dr), t2i = Ops::add(bi, di);
+                V t3r = Ops::sub(br, dr), t3i = Ops::sub(bi, di);
+
+                // X[j] = t0 + t2, X[j+m] = t1 - i*t3,
+                // X[j+2m] = t0 - t2, X[j+3m] = t1 + i*t3
+                Ops::store(r0 + j, Ops::add(t0r, t2r));
+                Ops::store(i0 + j, Ops::add(t0i, t2i));
+                Ops::store(r1 + j, Ops::add(t1r, t3i));
+                Ops::store(i1 + j, Ops::sub(t1i, t3r));
+                Ops::store(r2 + j, Ops::sub(t0r, t2r));
+                Ops::store(i2 + j, Ops::sub(t0i, t2i));
+                Ops::store(r3 + j, Ops::sub(t1r, t3i));
+                Ops::store(i3 + j, Ops::add(t1i, t3r));
+            }
+        }
+    }
+
+#ifdef AQUILA_HAVE_AVX2
+    void radix4StageAvx2(double* re, double* im, std::size_t n,
+                         std::size_t m, const double* twiddles);
+#endif
+}
+
+#endif // RADIX4FFTKERNEL_H
@@ -17,28 +17,157 @@
 
 #include "Spectrogram.h"
 #include "FftFactory.h"
-#include "../source/Frame.h"
+#include "../functions.h"
 #include "../source/FramesCollection.h"
+#include <cmath>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace Aquila
 {
     /**
      * Creates the spectrogram from a collection of signal frames.
      *
-     * Calculates frame spectra immediately after initialization.
+     * @param frames input frames
+     * @param storage what to store for each spectrogram point
+     * @param threads number of threads to use, 0 means OpenMP default
+     */
+    Spectrogram::Spectrogram(FramesCollection& frames, StorageType storage,
+                             unsigned int threads):
+        Spectrogram(frames.views(), storage, threads)
+    {
+    }
+
+    /**
+     * Creates the spectrogram from views of signal frames.
+     *
+     * Calculates frame spectra immediately after initialization. Frames
+     * are transformed in parallel; every thread has its own scratch
+     * buffer and writes only its frames' rows, so the result doesn't
+     * depend on the number of threads.
      *
      * @param frames input frames
+     * @param storage what to store for each spectrogram point
+     * @param threads number of threads to use, 0 means OpenMP default
      */
-    Spectrogram::Spectrogram(FramesCollection& frames):
-        m_frameCount(frames.count()),
+    Spectrogram::Spectrogram(const FrameViews& frames, StorageType storage,
+                             unsigned int threads):
+        m_frameCount(frames.size()),
         m_spectrumSize(frames.getSamplesPerFrame()),
+        m_binCount(m_spectrumSize / 2 + 1),
+        m_storage(storage),
         m_fft(FftFactory::getFft(m_spectrumSize)),
-        m_data(new SpectrogramDataType(m_frameCount))
+        m_complexData(), m_valueData()
+    {
+        if (ComplexStorage == m_storage)
+        {
+            m_complexData = std::make_shared<std::vector<ComplexType>>(
+                m_frameCount * m_binCount);
+        }
+        else
+        {
+            m_valueData = std::make_shared<std::vector<float>>(
+                m_frameCount * m_binCount);
+        }
+
+#ifdef _OPENMP
+        const int threadCount = threads > 0 ? static_cast<int>(threads)
+                                            : omp_get_max_threads();
+#else
+        const int threadCount = 1;
+        (void) threads;
+#endif
+        const long count = static_cast<long>(m_frameCount);
+        #pragma omp parallel num_threads(threadCount) if(threadCount > 1)
+        {
+            std::vector<ComplexType> spectrum;
+            if (ComplexStorage != m_storage)
+            {
+                spectrum.resize(m_binCount);
+            }
+
+            #pragma omp for schedule(static)
+            for (long i = 0; i < count; ++i)
+            {
+                calculateFrame(frames[i].data(), i, spectrum);
+            }
+        }
+    }
+
+    /**
+     * Returns a complex data point value at given coordinates.
+     *
+     * Bins above N/2 are not stored, but calculated as conjugates of
+     * the lower ones. Valid only for ComplexStorage.
+     *
+     * @param frame frame number (the x coordinate)
+     * @param peak spectral peak number (the y coordinate)
+     * @return spectrum value at given frame and peak number
+     */
+    ComplexType Spectrogram::getPoint(std::size_t frame, std::size_t peak) const
     {
-        std::size_t i = 0;
-        for (auto it = frames.begin(); it != frames.end(); ++it, ++i)
+        const ComplexType* row = getRow(frame);
+        if (peak < m_binCount)
+        {
+            return row[peak];
+        }
+        return std::conj(row[m_spectrumSize - peak]);
+    }
+
+    /**
+     * Returns a real value at given coordinates.
+     *
+     * This is the stored magnitude, power or decibel value, or magnitude
+     * of the complex value for ComplexStorage.
+     *
+     * @param frame frame number (the x coordinate)
+     * @param bin bin number, up to getBinCount() - 1 (the y coordinate)
+     * @return value at given frame and bin
+     */
+    double Spectrogram::getValue(std::size_t frame, std::size_t bin) const
+    {
+        if (ComplexStorage == m_storage)
+        {
+            return std::abs(getRow(frame)[bin]);
+        }
+        return getValueRow(frame)[bin];
+    }
+
+    /**
+     * Calculates a single row of the spectrogram.
+     *
+     * @param samples frame samples
+     * @param index frame number
+     * @param spectrum scratch buffer for getBinCount() values (unused
+     *                 for ComplexStorage)
+     */
+    void Spectrogram::calculateFrame(const SampleType samples[],
+                                     std::size_t index,
+                                     std::vector<ComplexType>& spectrum)
+    {
+        if (ComplexStorage == m_storage)
+        {
+            m_fft->rfft(samples, m_complexData->data() + index * m_binCount);
+            return;
+        }
+
+        m_fft->rfft(samples, spectrum.data());
+        float* row = m_valueData->data() + index * m_binCount;
+        for (std::size_t k = 0; k < m_binCount; ++k)
         {
-            (*m_data)[i] = m_fft->fft(it->toArray());
+            switch (m_storage)
+            {
+            case MagnitudeStorage:
+                row[k] = static_cast<float>(std::abs(spectrum[k]));
+                break;
+            case PowerStorage:
+                row[k] = static_cast<float>(std::norm(spectrum[k]));
+                break;
+            default:
+                row[k] = static_cast<float>(dB(spectrum[k]));
+                break;
+            }
         }
     }
 }
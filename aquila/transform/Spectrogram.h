@@ -28,16 +28,82 @@ namespace Aquila
 {
     class Fft;
     class FramesCollection;
+    class FrameViews;
 
     /**
      * Spectrogram class.
      *
-     * @todo copy constructor, safe point access, code cleanup
+     * Frames are real signals, so only N/2+1 non-redundant bins of each
+     * frame spectrum are stored, in a single contiguous buffer, frame
+     * after frame (row-major order, frames x bins). Instead of complex
+     * values, the spectrogram may store single precision magnitudes,
+     * powers or decibels, which needs up to 8 times less memory.
+     *
+     * Rows (spectra of single frames) are contiguous arrays; columns
+     * (values of a single bin over time) are accessed by strided views.
+     *
+     * @todo safe point access
      */
     class AQUILA_EXPORT Spectrogram
     {
     public:
-        Spectrogram(FramesCollection& frames);
+        /**
+         * What is stored for each spectrogram point.
+         */
+        enum StorageType {ComplexStorage, MagnitudeStorage, PowerStorage,
+                          DecibelStorage};
+
+        /**
+         * A read-only view of a single spectrogram column.
+         */
+        template <typename T>
+        class Column
+        {
+        public:
+            /**
+             * Creates the view.
+             *
+             * @param data pointer to the value in first row
+             * @param size number of rows
+             * @param stride distance between consecutive rows
+             */
+            Column(const T* data, std::size_t size, std::size_t stride):
+                m_data(data), m_size(size), m_stride(stride)
+            {
+            }
+
+            /**
+             * Returns number of values in the column.
+             *
+             * @return frame count
+             */
+            std::size_t size() const
+            {
+                return m_size;
+            }
+
+            /**
+             * Returns the value in a given frame.
+             *
+             * @param frame frame number
+             * @return value reference
+             */
+            const T& operator[](std::size_t frame) const
+            {
+                return m_data[frame * m_stride];
+            }
+
+        private:
+            const T* m_data;
+            std::size_t m_size, m_stride;
+        };
+
+        Spectrogram(FramesCollection& frames,
+                    StorageType storage = ComplexStorage,
+                    unsigned int threads = 0);
+        Spectrogram(const FrameViews& frames,
+                    StorageType storage = ComplexStorage,
+                    unsigned int threads = 0);
 
         /**
          * Returns number of frames (spectrogram width).
@@ -50,7 +116,7 @@ namespace Aquila
         }
 
         /**
-         * Returns spectrum size (spectrogram height).
+         * Returns spectrum size (FFT length of each frame).
          *
          * @return spectrum size
          */
@@ -60,22 +126,85 @@ namespace Aquila
         }
 
         /**
-         * Returns a complex data point value at given coordinates.
+         * Returns number of stored bins of each frame (spectrogram height).
          *
-         * @param frame frame number (the x coordinate)
-         * @param peak spectral peak number (the y coordinate)
-         * @return spectrum value at given frame and peak number
+         * @return getSpectrumSize() / 2 + 1
          */
-        ComplexType getPoint(std::size_t frame, std::size_t peak) const
+        std::size_t getBinCount() const
         {
-            return (*m_data)[frame][peak];
+            return m_binCount;
+        }
+
+        /**
+         * Returns what the spectrogram stores.
+         *
+         * @return storage type
+         */
+        StorageType getStorageType() const
+        {
+            return m_storage;
+        }
+
+        ComplexType getPoint(std::size_t frame, std::size_t peak) const;
+        double getValue(std::size_t frame, std::size_t bin) const;
+
+        /**
+         * Returns the half spectrum of a given frame.
+         *
+         * Valid only for ComplexStorage.
+         *
+         * @param frame frame number
+         * @return pointer to getBinCount() complex values
+         */
+        const ComplexType* getRow(std::size_t frame) const
+        {
+            return m_complexData->data() + frame * m_binCount;
+        }
+
+        /**
+         * Returns stored values of a given frame.
+         *
+         * Valid for all storage types except ComplexStorage.
+         *
+         * @param frame frame number
+         * @return pointer to getBinCount() values
+         */
+        const float* getValueRow(std::size_t frame) const
+        {
+            return m_valueData->data() + frame * m_binCount;
+        }
+
+        /**
+         * Returns values of a given bin in all frames.
+         *
+         * Valid only for ComplexStorage.
+         *
+         * @param bin bin number
+         * @return column view
+         */
+        Column<ComplexType> getColumn(std::size_t bin) const
+        {
+            return Column<ComplexType>(m_complexData->data() + bin,
+                                       m_frameCount, m_binCount);
         }
 
-    private:
         /**
-         * Spectrogram data type used for internal storage.
+         * Returns stored values of a given bin in all frames.
+         *
+         * Valid for all storage types except ComplexStorage.
+         *
+         * @param bin bin number
+         * @return column view
          */
-        typedef std::vector<SpectrumType> SpectrogramDataType;
+        Column<float> getValueColumn(std::size_t bin) const
+        {
+            return Column<float>(m_valueData->data() + bin,
+                                 m_frameCount, m_binCount);
+        }
+
+    private:
+        void calculateFrame(const SampleType samples[], std::size_t index,
+                            std::vector<ComplexType>& spectrum);
 
         /**
          * Frame count (width of the spectrogram).
@@ -83,19 +212,34 @@ namespace Aquila
         std::size_t m_frameCount;
 
         /**
-         * Spectrum size (height of the spectrogram).
+         * Spectrum size (FFT length).
          */
         std::size_t m_spectrumSize;
 
+        /**
+         * Number of bins stored for each frame (height of the spectrogram).
+         */
+        std::size_t m_binCount;
+
+        /**
+         * What is stored for each point.
+         */
+        StorageType m_storage;
+
         /**
          * A shared pointer to FFT algorithm class.
          */
-        std::shared_ptr<Fft> m_fft;
+        std::shared_ptr<const Fft> m_fft;
+
+        /**
+         * Half spectra of all frames, for ComplexStorage.
+         */
+        std::shared_ptr<std::vector<ComplexType>> m_complexData;
 
         /**
-         * A shared pointer to spectrogram data.
+         * Magnitudes, powers or decibels of all frames, for other storage types.
          */
-        std::shared_ptr<SpectrogramDataType> m_data;
+        std::shared_ptr<std::vector<float>> m_valueData;
     };
 }
 
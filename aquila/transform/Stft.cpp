@@ -0,0 +1,235 @@
+/**
+ * @file Stft.cpp
+ *
+ * Short-time Fourier transform with an analysis window.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#include "Stft.h"
+#include "FftFactory.h"
+#include "../Exceptions.h"
+#include "../source/SignalSource.h"
+#include "../source/window/BarlettWindow.h"
+#include "../source/window/BlackmanWindow.h"
+#include "../source/window/FlattopWindow.h"
+#include "../source/window/HammingWindow.h"
+#include "../source/window/HannWindow.h"
+#include "../source/window/RectangularWindow.h"
+#include <map>
+#include <mutex>
+#include <utility>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace Aquila
+{
+    namespace
+    {
+        /**
+         * Cached window tables, keyed by window type and length.
+         */
+        std::map<std::pair<Stft::WindowType, std::size_t>,
+                 std::shared_ptr<const std::vector<SampleType>>> windowCache;
+
+        /**
+         * Guards access to the window cache.
+         */
+        std::mutex windowCacheMutex;
+
+        /**
+         * Copies window samples into a table.
+         *
+         * @param window window signal
+         * @return window table
+         */
+        std::vector<SampleType>* windowTable(const SignalSource& window)
+        {
+            return new std::vector<SampleType>(
+                window.toArray(), window.toArray() + window.getSamplesCount());
+        }
+
+        /**
+         * Creates a window table using the window classes.
+         *
+         * @param window window type
+         * @param length window length
+         * @return window table
+         */
+        std::vector<SampleType>* createWindow(Stft::WindowType window,
+                                              std::size_t length)
+        {
+            switch (window)
+            {
+            case Stft::Rectangular:
+                return windowTable(RectangularWindow(length));
+            case Stft::Hann:
+                return windowTable(HannWindow(length));
+            case Stft::Hamming:
+                return windowTable(HammingWindow(length));
+            case Stft::Blackman:
+                return windowTable(BlackmanWindow(length));
+            case Stft::Barlett:
+                return windowTable(BarlettWindow(length));
+            case Stft::Flattop:
+                return windowTable(FlattopWindow(length));
+            }
+            throw Exception("Unknown window type");
+        }
+    }
+
+    /**
+     * Creates the transform for a given frame layout and window.
+     *
+     * @param frameLength number of samples in each frame (FFT length)
+     * @param hopLength distance between consecutive frames in samples
+     * @param window analysis window type
+     * @throw Aquila::Exception if frame or hop length is zero
+     */
+    Stft::Stft(std::size_t frameLength, std::size_t hopLength,
+               WindowType window):
+        m_frameLength(frameLength), m_hopLength(hopLength),
+        m_windowType(window), m_window(), m_fft()
+    {
+        if (0 == m_frameLength || 0 == m_hopLength)
+        {
+            throw Exception("STFT frame and hop length must be positive");
+        }
+        m_window = getWindow(m_windowType, m_frameLength);
+        m_fft = FftFactory::getFft(m_frameLength);
+    }
+
+    /**
+     * Returns a window table, computing it on first request.
+     *
+     * The table is then shared by all callers asking for the same
+     * window type and length.
+     *
+     * @param window window type
+     * @param length window length
+     * @return window table (wrapped in a shared_ptr)
+     */
+    std::shared_ptr<const std::vector<SampleType>> Stft::getWindow(
+        WindowType window, std::size_t length)
+    {
+        const auto key = std::make_pair(window, length);
+
+        std::lock_guard<std::mutex> lock(windowCacheMutex);
+        auto it = windowCache.find(key);
+        if (it != windowCache.end())
+        {
+            return it->second;
+        }
+        std::shared_ptr<const std::vector<SampleType>> table(
+            createWindow(window, length));
+        windowCache[key] = table;
+        return table;
+    }
+
+    /**
+     * Releases all cached window tables.
+     *
+     * Tables still used by Stft objects remain valid.
+     */
+    void Stft::clearWindowCache()
+    {
+        std::lock_guard<std::mutex> lock(windowCacheMutex);
+        windowCache.clear();
+    }
+
+    /**
+     * Returns the number of full frames in a signal.
+     *
+     * @param signalLength number of samples in the signal
+     * @return frame count
+     */
+    std::size_t Stft::getFrameCount(std::size_t signalLength) const
+    {
+        if (signalLength < m_frameLength)
+        {
+            return 0;
+        }
+        return (signalLength - m_frameLength) / m_hopLength + 1;
+    }
+
+    /**
+     * Calculates the spectrum of a single windowed frame.
+     *
+     * @param samples getFrameLength() samples
+     * @param spectrum room for getBinCount() values
+     */
+    void Stft::transformFrame(const SampleType samples[],
+                              ComplexType spectrum[]) const
+    {
+        thread_local std::vector<SampleType> windowed;
+        if (windowed.size() < m_frameLength)
+        {
+            windowed.resize(m_frameLength);
+        }
+
+        const SampleType* window = m_window->data();
+        SampleType* input = windowed.data();
+        for (std::size_t n = 0; n < m_frameLength; ++n)
+        {
+            input[n] = samples[n] * window[n];
+        }
+        m_fft->rfft(input, spectrum);
+    }
+
+    /**
+     * Calculates spectra of all full frames of a signal.
+     *
+     * Frames are transformed in parallel; each writes only its own
+     * part of the output, so the result doesn't depend on the number
+     * of threads.
+     *
+     * @param samples signal samples
+     * @param length number of samples
+     * @param output room for getFrameCount(length) * getBinCount() values
+     * @param threads number of threads to use, 0 means OpenMP default
+     */
+    void Stft::transform(const SampleType samples[], std::size_t length,
+                         ComplexType output[], unsigned int threads) const
+    {
+#ifdef _OPENMP
+        const int threadCount = threads > 0 ? static_cast<int>(threads)
+                                            : omp_get_max_threads();
+#else
+        const int threadCount = 1;
+        (void) threads;
+#endif
+        const long count = static_cast<long>(getFrameCount(length));
+        const std::size_t binCount = getBinCount();
+        #pragma omp parallel for num_threads(threadCount) if(threadCount > 1) schedule(static)
+        for (long i = 0; i < count; ++i)
+        {
+            transformFrame(samples + i * m_hopLength, output + i * binCount);
+        }
+    }
+
+    /**
+     * Calculates spectra of all full frames of a signal.
+     *
+     * @param source input signal
+     * @param threads number of threads to use, 0 means OpenMP default
+     * @return getFrameCount() * getBinCount() values, frame by frame
+     */
+    std::vector<ComplexType> Stft::transform(const SignalSource& source,
+                                             unsigned int threads) const
+    {
+        const std::size_t length = source.getSamplesCount();
+        std::vector<ComplexType> output(getFrameCount(length) * getBinCount());
+        transform(source.toArray(), length, output.data(), threads);
+        return output;
+    }
+}
@@ -0,0 +1,152 @@
+/**
+ * @file Stft.h
+ *
+ * Short-time Fourier transform with an analysis window.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#ifndef STFT_H
+#define STFT_H
+
+#include "../global.h"
+#include "Fft.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Aquila
+{
+    class SignalSource;
+
+    /**
+     * Short-time Fourier transform with an analysis window.
+     *
+     * The signal is divided into overlapping frames of frameLength
+     * samples, hopLength samples apart. Each frame is multiplied by the
+     * window while being copied into the FFT input, so no windowed
+     * frame objects are created, and then transformed with a real FFT.
+     * Only full frames are transformed, as in FramesCollection.
+     *
+     * Window tables are computed once per window type and length and
+     * shared by all Stft objects (see getWindow()).
+     *
+     * The result is stored frame by frame, getBinCount() (N/2+1) complex
+     * values per frame, in one contiguous vector.
+     *
+     * Stft objects are immutable, so one object can be used by many
+     * threads at once.
+     */
+    class AQUILA_EXPORT Stft
+    {
+    public:
+        /**
+         * Available analysis windows.
+         */
+        enum WindowType {Rectangular, Hann, Hamming, Blackman, Barlett,
+                         Flattop};
+
+        Stft(std::size_t frameLength, std::size_t hopLength,
+             WindowType window = Hann);
+
+        static std::shared_ptr<const std::vector<SampleType>> getWindow(
+            WindowType window, std::size_t length);
+        static void clearWindowCache();
+
+        std::size_t getFrameCount(std::size_t signalLength) const;
+
+        void transformFrame(const SampleType samples[],
+                            ComplexType spectrum[]) const;
+        void transform(const SampleType samples[], std::size_t length,
+                       ComplexType output[], unsigned int threads = 0) const;
+        std::vector<ComplexType> transform(const SignalSource& source,
+                                           unsigned int threads = 0) const;
+
+        /**
+         * Returns the number of samples in each frame (FFT length).
+         *
+         * @return frame length
+         */
+        std::size_t getFrameLength() const
+        {
+            return m_frameLength;
+        }
+
+        /**
+         * Returns the distance between consecutive frames.
+         *
+         * @return hop length in samples
+         */
+        std::size_t getHopLength() const
+        {
+            return m_hopLength;
+        }
+
+        /**
+         * Returns the number of stored bins in each frame's spectrum.
+         *
+         * @return frame length / 2 + 1
+         */
+        std::size_t getBinCount() const
+        {
+            return m_frameLength / 2 + 1;
+        }
+
+        /**
+         * Returns the analysis window type.
+         *
+         * @return window type
+         */
+        WindowType getWindowType() const
+        {
+            return m_windowType;
+        }
+
+        /**
+         * Returns the analysis window values.
+         *
+         * @return window table of frame length
+         */
+        const std::vector<SampleType>& getWindowTable() const
+        {
+            return *m_window;
+        }
+
+    private:
+        /**
+         * Frame length.
+         */
+        const std::size_t m_frameLength;
+
+        /**
+         * Distance between frames.
+         */
+        const std::size_t m_hopLength;
+
+        /**
+         * Analysis window type.
+         */
+        const WindowType m_windowType;
+
+        /**
+         * Cached window table.
+         */
+        std::shared_ptr<const std::vector<SampleType>> m_window;
+
+        /**
+         * FFT of the frame length.
+         */
+        std::shared_ptr<const Fft> m_fft;
+    };
+}
+
+#endif // STFT_H
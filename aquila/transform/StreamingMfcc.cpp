@@ -0,0 +1,233 @@
+/**
+ * @file StreamingMfcc.cpp
+ *
+ * Calculation of MFCC features from a stream of sample blocks.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#include "StreamingMfcc.h"
+#include "../Exceptions.h"
+#include <algorithm>
+
+namespace Aquila
+{
+    /**
+     * Creates the extractor and allocates all its buffers.
+     *
+     * @param sampleFrequency sample frequency of the stream in Hz
+     * @param frameSize number of samples in each frame
+     * @param hopSize distance between consecutive frames in samples
+     * @param numFeatures how many MFCC features to calculate per frame
+     * @param deltaWindow number of frames on each side used for deltas
+     *                    (must be positive)
+     * @param numFilters number of Mel filters
+     * @param lifterCoeff liftering coefficient
+     * @throw Aquila::Exception if hop size or delta window is zero
+     */
+    StreamingMfcc::StreamingMfcc(FrequencyType sampleFrequency,
+                                 std::size_t frameSize, std::size_t hopSize,
+                                 std::size_t numFeatures,
+                                 std::size_t deltaWindow,
+                                 std::size_t numFilters, double lifterCoeff):
+        m_frameSize(frameSize), m_hopSize(hopSize),
+        m_numFeatures(numFeatures), m_deltaWindow(deltaWindow),
+        m_mfcc(frameSize, numFilters, lifterCoeff),
+        m_bank(sampleFrequency, frameSize,
+               m_mfcc.getMelFilterWidth(sampleFrequency), numFilters),
+        m_dct(numFilters, numFeatures), m_lifter(numFeatures, lifterCoeff),
+        m_samples(2 * frameSize, 0), m_writePosition(0),
+        m_missingSamples(frameSize),
+        m_statics((4 * deltaWindow + 1) * numFeatures, 0.0),
+        m_frames(0), m_emitted(0), m_output(3 * numFeatures, 0.0),
+        m_deltaMinus(numFeatures, 0.0), m_deltaPlus(numFeatures, 0.0)
+    {
+        if (0 == m_hopSize || 0 == m_deltaWindow)
+        {
+            throw Exception("Streaming MFCC hop size and delta window must be positive");
+        }
+    }
+
+    /**
+     * Processes a block of samples.
+     *
+     * The callback is called for every feature vector which became
+     * available thanks to this block - possibly none or many of them.
+     *
+     * @param samples block of samples
+     * @param count number of samples in the block
+     * @param callback receiver of feature vectors
+     */
+    void StreamingMfcc::process(const SampleType samples[], std::size_t count,
+                                const Callback& callback)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            m_samples[m_writePosition] = samples[i];
+            m_samples[m_writePosition + m_frameSize] = samples[i];
+            m_writePosition = (m_writePosition + 1) % m_frameSize;
+
+            if (--m_missingSamples == 0)
+            {
+                addFrame();
+                m_missingSamples = m_hopSize;
+                if (m_frames > 2 * m_deltaWindow)
+                {
+                    emit(m_frames - 1 - 2 * m_deltaWindow, m_frames - 1,
+                         callback);
+                }
+            }
+        }
+    }
+
+    /**
+     * Processes a block of samples.
+     *
+     * @param block block of samples
+     * @param callback receiver of feature vectors
+     */
+    void StreamingMfcc::process(const std::vector<SampleType>& block,
+                                const Callback& callback)
+    {
+        process(block.data(), block.size(), callback);
+    }
+
+    /**
+     * Emits features of all remaining frames at the end of the stream.
+     *
+     * Samples of an incomplete last frame are discarded. The extractor
+     * is reset afterwards and can process a new stream.
+     *
+     * @param callback receiver of feature vectors
+     */
+    void StreamingMfcc::flush(const Callback& callback)
+    {
+        for (std::size_t frame = m_emitted; frame < m_frames; ++frame)
+        {
+            emit(frame, m_frames - 1, callback);
+        }
+        reset();
+    }
+
+    /**
+     * Forgets all the samples and frames processed so far.
+     */
+    void StreamingMfcc::reset()
+    {
+        std::fill(m_samples.begin(), m_samples.end(), 0);
+        m_writePosition = 0;
+        m_missingSamples = m_frameSize;
+        m_frames = 0;
+        m_emitted = 0;
+    }
+
+    /**
+     * Calculates MFCC of the frame formed by last frameSize samples.
+     */
+    void StreamingMfcc::addFrame()
+    {
+        const std::size_t slot = m_frames % (4 * m_deltaWindow + 1);
+        m_mfcc.calculateFrame(&m_samples[m_writePosition], m_frameSize,
+                              Mfcc::Cepstra, &m_bank, &m_dct, &m_lifter,
+                              &m_statics[slot * m_numFeatures]);
+        ++m_frames;
+    }
+
+    /**
+     * Calculates the full feature vector of a frame and passes it on.
+     *
+     * @param frame index of the frame
+     * @param lastFrame index of the last known frame
+     * @param callback receiver of the feature vector
+     */
+    void StreamingMfcc::emit(std::size_t frame, std::size_t lastFrame,
+                             const Callback& callback)
+    {
+        const long t = static_cast<long>(frame);
+        const double* statics = staticFeatures(t, lastFrame);
+        std::copy(statics, statics + m_numFeatures, m_output.begin());
+
+        double* deltas = &m_output[m_numFeatures];
+        delta(t, lastFrame, deltas);
+
+        double* deltaDeltas = &m_output[2 * m_numFeatures];
+        std::fill(deltaDeltas, deltaDeltas + m_numFeatures, 0.0);
+        double norm = 0.0;
+        for (std::size_t n = 1; n <= m_deltaWindow; ++n)
+        {
+            const long offset = static_cast<long>(n);
+            delta(t + offset, lastFrame, &m_deltaPlus[0]);
+            delta(t - offset, lastFrame, &m_deltaMinus[0]);
+            for (std::size_t i = 0; i < m_numFeatures; ++i)
+            {
+                deltaDeltas[i] += n * (m_deltaPlus[i] - m_deltaMinus[i]);
+            }
+            norm += 2.0 * n * n;
+        }
+        for (std::size_t i = 0; i < m_numFeatures; ++i)
+        {
+            deltaDeltas[i] /= norm;
+        }
+
+        callback(m_output.data(), frame);
+        ++m_emitted;
+    }
+
+    /**
+     * Returns MFCC of a frame, replicating first and last frames.
+     *
+     * @param frame index of the frame (may be out of range)
+     * @param lastFrame index of the last known frame
+     * @return pointer to numFeatures values
+     */
+    const double* StreamingMfcc::staticFeatures(long frame,
+                                                std::size_t lastFrame) const
+    {
+        const std::size_t clamped = static_cast<std::size_t>(
+            std::min(std::max(frame, 0L), static_cast<long>(lastFrame)));
+        const std::size_t slot = clamped % (4 * m_deltaWindow + 1);
+        return &m_statics[slot * m_numFeatures];
+    }
+
+    /**
+     * Calculates deltas of a frame, replicating first and last frames.
+     *
+     * d[t] = sum(n * (c[t+n] - c[t-n])) / (2 * sum(n^2)), n = 1..deltaWindow
+     *
+     * @param frame index of the frame (may be out of range)
+     * @param lastFrame index of the last known frame
+     * @param output room for numFeatures values
+     */
+    void StreamingMfcc::delta(long frame, std::size_t lastFrame,
+                              double output[]) const
+    {
+        const long t = std::min(std::max(frame, 0L),
+                                static_cast<long>(lastFrame));
+        std::fill(output, output + m_numFeatures, 0.0);
+        double norm = 0.0;
+        for (std::size_t n = 1; n <= m_deltaWindow; ++n)
+        {
+            const long offset = static_cast<long>(n);
+            const double* plus = staticFeatures(t + offset, lastFrame);
+            const double* minus = staticFeatures(t - offset, lastFrame);
+            for (std::size_t i = 0; i < m_numFeatures; ++i)
+            {
+                output[i] += n * (plus[i] - minus[i]);
+            }
+            norm += 2.0 * n * n;
+        }
+        for (std::size_t i = 0; i < m_numFeatures; ++i)
+        {
+            output[i] /= norm;
+        }
+    }
+}
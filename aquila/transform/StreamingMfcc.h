@@ -0,0 +1,162 @@
+/**
+ * @file StreamingMfcc.h
+ *
+ * Calculation of MFCC features from a stream of sample blocks.
+ *
+ * This file is part of the Aquila DSP library.
+ * Aquila is free software, licensed under the MIT/X11 License. A copy of
+ * the license is provided with the library in the LICENSE file.
+ *
+ * @package Aquila
+ * @version 3.0.0-dev
+ * @author Zbigniew Siciarz
+ * @date 2007-2014
+ * @license http://www.opensource.org/licenses/mit-license.php MIT
+ * @since 3.0.0
+ */
+
+#ifndef STREAMINGMFCC_H
+#define STREAMINGMFCC_H
+
+#include "../global.h"
+#include "DctPlan.h"
+#include "Lifter.h"
+#include "Mfcc.h"
+#include "../filter/MelFilterBank.h"
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace Aquila
+{
+    /**
+     * Calculates MFCC, delta and delta-delta features of a live signal.
+     *
+     * Samples are fed in blocks of any size, for example as they come
+     * from a sound card or WaveFile::load_next(). The extractor keeps
+     * the last frameSize samples in a ring buffer and calculates MFCC
+     * of every frame as soon as it is complete, hopSize samples after
+     * the previous one.
+     *
+     * Deltas are calculated with the usual regression formula over
+     * deltaWindow frames on each side, so a frame's feature vector can
+     * be emitted only when 2 * deltaWindow later frames are known. The
+     * latency is therefore constant and does not depend on signal
+     * length. At the end of the stream flush() emits the remaining
+     * frames, replicating the last one as needed (the first frame is
+     * replicated in the same way at the beginning).
+     *
+     * Feature vectors are passed to a callback, as 3 * numFeatures
+     * values: MFCC, deltas and delta-deltas. All buffers are allocated
+     * in the constructor, so processing a block doesn't allocate memory.
+     *
+     * StreamingMfcc mfcc(8000, 256, 80);
+     * while (...) {
+     *    auto block = wav.load_next();
+     *    mfcc.process(block[0], [] (const double* features, std::size_t i) {
+     *        // do something with features of i-th frame
+     *    });
+     * }
+     * mfcc.flush(...);
+     */
+    class AQUILA_EXPORT StreamingMfcc
+    {
+    public:
+        /**
+         * Receives feature vector of a frame and the frame's index.
+         */
+        typedef std::function<void (const double*, std::size_t)> Callback;
+
+        StreamingMfcc(FrequencyType sampleFrequency, std::size_t frameSize,
+                      std::size_t hopSize, std::size_t numFeatures = 12,
+                      std::size_t deltaWindow = 2, std::size_t numFilters = 26,
+                      double lifterCoeff = 22.0);
+        StreamingMfcc(const StreamingMfcc&) = delete;
+        StreamingMfcc& operator=(const StreamingMfcc&) = delete;
+
+        void process(const SampleType samples[], std::size_t count,
+                     const Callback& callback);
+        void process(const std::vector<SampleType>& block,
+                     const Callback& callback);
+        void flush(const Callback& callback);
+        void reset();
+
+        /**
+         * Returns the length of emitted feature vectors.
+         *
+         * @return 3 * numFeatures
+         */
+        std::size_t getFeatureVectorSize() const
+        {
+            return 3 * m_numFeatures;
+        }
+
+        /**
+         * Returns the number of frames whose features were emitted.
+         *
+         * @return number of emitted frames
+         */
+        std::size_t getEmittedCount() const
+        {
+            return m_emitted;
+        }
+
+    private:
+        void addFrame();
+        void emit(std::size_t frame, std::size_t lastFrame,
+                  const Callback& callback);
+        const double* staticFeatures(long frame, std::size_t lastFrame) const;
+        void delta(long frame, std::size_t lastFrame, double output[]) const;
+
+        const std::size_t m_frameSize;
+        const std::size_t m_hopSize;
+        const std::size_t m_numFeatures;
+        const std::size_t m_deltaWindow;
+
+        /**
+         * Per-frame MFCC calculation.
+         */
+        Mfcc m_mfcc;
+        MelFilterBank m_bank;
+        DctPlan m_dct;
+        Lifter m_lifter;
+
+        /**
+         * Last frameSize samples, stored twice so that the whole frame
+         * is always contiguous.
+         */
+        std::vector<SampleType> m_samples;
+
+        /**
+         * Where the next sample is written to (modulo frame size).
+         */
+        std::size_t m_writePosition;
+
+        /**
+         * Samples still missing to complete the next frame.
+         */
+        std::size_t m_missingSamples;
+
+        /**
+         * MFCC of the last 4 * deltaWindow + 1 frames, ring buffer.
+         */
+        std::vector<double> m_statics;
+
+        /**
+         * Number of frames calculated so far.
+         */
+        std::size_t m_frames;
+
+        /**
+         * Number of frames emitted so far.
+         */
+        std::size_t m_emitted;
+
+        /**
+         * Output feature vector and scratch space for deltas.
+         */
+        std::vector<double> m_output, m_deltaMinus, m_deltaPlus;
+    };
+}
+
+#endif // STREAMINGMFCC_H
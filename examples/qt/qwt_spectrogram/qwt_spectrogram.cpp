@@ -2,7 +2,7 @@
 #include "aquila/functions.h"
 #include "aquila/source/WaveFile.h"
 #include "aquila/source/generator/SineGenerator.h"
-#include "aquila/source/FramesCollection.h"
+#include "aquila/source/FrameView.h"
 #include "aquila/transform/Spectrogram.h"
 #include <QApplication>
 #include <QMainWindow>
@@ -62,7 +62,7 @@ int main(int argc, char *argv[])
         source = generator;
     }
 
-    Aquila::FramesCollection frames(*source, 1024);
+    Aquila::FrameViews frames(*source, 1024);
     Aquila::Spectrogram spectrogram(frames);
 
     QApplication a(argc, argv);
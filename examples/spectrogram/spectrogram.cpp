@@ -1,7 +1,7 @@
 #include "aquila/source/generator/SineGenerator.h"
 #include "aquila/source/generator/SquareGenerator.h"
 #include "aquila/source/generator/TriangleGenerator.h"
-#include "aquila/source/FramesCollection.h"
+#include "aquila/source/FrameView.h"
 #include "aquila/transform/Spectrogram.h"
 #include "aquila/functions.h"
 #include <cstdlib>
@@ -39,8 +39,8 @@ int main(int argc, char *argv[])
     }
     generator->setFrequency(SIGNAL_FREQUENCY).setAmplitude(255).generate(SAMPLES_PER_SIGNAL);
 
-    Aquila::FramesCollection frames(*generator, SAMPLES_PER_FRAME);
-    std::cout << frames.count() << " frames after division" << std::endl;
+    Aquila::FrameViews frames(*generator, SAMPLES_PER_FRAME);
+    std::cout << frames.size() << " frames after division" << std::endl;
 
     Aquila::Spectrogram spectrogram(frames);
 
@@ -0,0 +1,18 @@
+/**
+ * Counting of heap allocations made by the test program.
+ *
+ * The global allocation functions are replaced in AllocationCounter.cpp,
+ * so every operator new in the test executable is counted.
+ */
+
+#ifndef AQUILA_TEST_ALLOCATIONCOUNTER_H
+#define AQUILA_TEST_ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+
+/**
+ * Returns the number of allocations made since the program started.
+ */
+std::size_t allocationCount();
+
+#endif // AQUILA_TEST_ALLOCATIONCOUNTER_H
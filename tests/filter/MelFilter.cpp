@@ -1,6 +1,7 @@
 #include "aquila/global.h"
 #include "aquila/filter/MelFilter.h"
 #include "UnitTest++/UnitTest++.h"
+#include <algorithm>
 #include <cstddef>
 
 
@@ -64,4 +65,21 @@ SUITE(MelFilter)
         double output = filter.apply(spectrum);
         CHECK_CLOSE(5000.0, output, 100);
     }
+
+    TEST(NonZeroRange)
+    {
+        Aquila::FrequencyType sampleFrequency = 44100.0;
+        const std::size_t N = 2048;
+
+        Aquila::MelFilter filter(sampleFrequency);
+        filter.createFilter(3, 200, N);
+        auto& weights = filter.getWeights();
+
+        CHECK(filter.getFirstBin() > 0u);
+        CHECK(weights.size() > 2u);
+        CHECK(weights.size() < N / 2);
+        CHECK_CLOSE(0.0, weights.front(), 0.000001);
+        CHECK_CLOSE(0.0, weights.back(), 0.000001);
+        CHECK_CLOSE(1.0, *std::max_element(weights.begin(), weights.end()), 0.1);
+    }
 }
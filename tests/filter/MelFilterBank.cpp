@@ -2,6 +2,7 @@
 #include "aquila/filter/MelFilter.h"
 #include "aquila/filter/MelFilterBank.h"
 #include "UnitTest++/UnitTest++.h"
+#include <cmath>
 #include <cstddef>
 #include <vector>
 
@@ -25,6 +26,19 @@ void testMelFilterBankOutput()
     }
 }
 
+/**
+ * Returns a power spectrum of given size with some non-zero content.
+ */
+static std::vector<double> testPowerSpectrum(std::size_t size, double phase)
+{
+    std::vector<double> pspec(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        pspec[i] = 1.0 + std::sin(0.05 * i + phase) * std::sin(0.05 * i + phase);
+    }
+    return pspec;
+}
+
 
 SUITE(MelFilterBank)
 {
@@ -54,4 +68,73 @@ SUITE(MelFilterBank)
     {
         testMelFilterBankOutput<4096>();
     }
+
+    TEST(SameAsSingleFilters)
+    {
+        const std::size_t N = 512;
+        const Aquila::FrequencyType sampleFrequency = 16000.0;
+        Aquila::MelFilterBank filters(sampleFrequency, N, 150.0, 26);
+        auto pspec = testPowerSpectrum(N / 2 + 1, 0.0);
+        Aquila::SpectrumType spectrum(pspec.begin(), pspec.end());
+
+        auto output = filters.applyAll(pspec);
+        auto complexOutput = filters.applyAll(spectrum);
+
+        CHECK_EQUAL(26u, output.size());
+        for (std::size_t k = 0; k < filters.size(); ++k)
+        {
+            Aquila::MelFilter filter(sampleFrequency);
+            filter.createFilter(k, 150.0, N);
+            CHECK_CLOSE(filter.apply(pspec), output[k], 0.000001);
+            CHECK_CLOSE(filter.apply(spectrum), complexOutput[k], 0.000001);
+        }
+    }
+
+    TEST(StoresOnlyTriangles)
+    {
+        const std::size_t N = 512;
+        Aquila::MelFilterBank filters(16000.0, N, 150.0, 26);
+
+        CHECK(filters.getWeightsCount() > 0u);
+        CHECK(filters.getWeightsCount() < 2 * (N / 2 + 1));
+    }
+
+    TEST(ShorterSpectrum)
+    {
+        const std::size_t N = 512;
+        const Aquila::FrequencyType sampleFrequency = 16000.0;
+        Aquila::MelFilterBank filters(sampleFrequency, N, 150.0, 26);
+        auto pspec = testPowerSpectrum(N / 2, 0.0);
+
+        auto output = filters.applyAll(pspec);
+
+        for (std::size_t k = 0; k < filters.size(); ++k)
+        {
+            Aquila::MelFilter filter(sampleFrequency);
+            filter.createFilter(k, 150.0, N);
+            CHECK_CLOSE(filter.apply(pspec), output[k], 0.000001);
+        }
+    }
+
+    TEST(Batch)
+    {
+        const std::size_t N = 256, SPECTRUM_SIZE = N / 2 + 1, FRAMES = 5;
+        Aquila::MelFilterBank filters(8000.0, N, 200.0, 20);
+
+        std::vector<double> spectra;
+        for (std::size_t i = 0; i < FRAMES; ++i)
+        {
+            auto pspec = testPowerSpectrum(SPECTRUM_SIZE, 0.3 * i);
+            spectra.insert(spectra.end(), pspec.begin(), pspec.end());
+        }
+        std::vector<double> output(FRAMES * filters.size());
+        filters.applyAll(spectra.data(), SPECTRUM_SIZE, FRAMES, output.data());
+
+        for (std::size_t i = 0; i < FRAMES; ++i)
+        {
+            auto expected = filters.applyAll(testPowerSpectrum(SPECTRUM_SIZE, 0.3 * i));
+            CHECK_ARRAY_CLOSE(expected, &output[i * filters.size()],
+                              filters.size(), 0.000001);
+        }
+    }
 }
@@ -0,0 +1,77 @@
+#include "aquila/global.h"
+#include "aquila/source/SignalSource.h"
+#include "aquila/source/FrameView.h"
+#include "UnitTest++/UnitTest++.h"
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+
+
+SUITE(FrameView)
+{
+    const int SIZE = 10;
+    Aquila::SampleType testArray[SIZE] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    Aquila::FrequencyType sampleFrequency = 100;
+    Aquila::SignalSource data(testArray, SIZE, sampleFrequency);
+
+    TEST(Empty)
+    {
+        Aquila::FrameViews views;
+        CHECK_EQUAL(0u, views.size());
+        CHECK(views.begin() == views.end());
+    }
+
+    TEST(ZeroSamplesPerFrame)
+    {
+        Aquila::FrameViews views(data, 0);
+        CHECK_EQUAL(0u, views.size());
+    }
+
+    TEST(TooManySamplesPerFrame)
+    {
+        Aquila::FrameViews views(data, 11);
+        CHECK_EQUAL(0u, views.size());
+    }
+
+    TEST(FrameSamples)
+    {
+        Aquila::FrameViews views(data, 4, 1);
+        CHECK_EQUAL(3u, views.size());
+        CHECK_EQUAL(3u, views.getHop());
+        Aquila::SampleType arr[4] = {3, 4, 5, 6};
+        Aquila::FrameView frame = views[1];
+        CHECK_EQUAL(4u, frame.size());
+        CHECK_ARRAY_EQUAL(arr, frame.data(), 4);
+        CHECK(std::equal(frame.begin(), frame.end(), arr));
+        CHECK_EQUAL(5, frame[2]);
+    }
+
+    TEST(SameLayoutAsOverlappingFrames)
+    {
+        // 80% overlap, as in FramesCollection DurationWithOverlap test
+        Aquila::FrameViews views(data, 5, 4);
+        CHECK_EQUAL(6u, views.size());
+        CHECK_EQUAL(5, views[5][0]);
+    }
+
+    TEST(RandomAccessIteration)
+    {
+        Aquila::FrameViews views(data, 2);
+        auto it = views.begin();
+        CHECK_EQUAL(5, views.end() - it);
+        CHECK_EQUAL(4, it[2][0]);
+        it += 3;
+        CHECK_EQUAL(6, (*it)[0]);
+        --it;
+        CHECK_EQUAL(4, (*it)[0]);
+        CHECK(it < views.end());
+        CHECK(views.end() - 1 > it);
+
+        Aquila::SampleType sum = 0;
+        for (auto frame : views)
+        {
+            sum += std::accumulate(frame.begin(), frame.end(), Aquila::SampleType(0));
+        }
+        CHECK_EQUAL(45, sum);
+    }
+}
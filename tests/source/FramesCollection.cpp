@@ -93,6 +93,18 @@ SUITE(FramesCollection)
         }
     }
 
+    TEST(Views)
+    {
+        Aquila::FramesCollection frames(data, 4, 2);
+        const Aquila::FrameViews& views = frames.views();
+        CHECK_EQUAL(frames.count(), views.size());
+        for (std::size_t i = 0; i < frames.count(); ++i)
+        {
+            CHECK_EQUAL(frames.frame(i).toArray(), views[i].data());
+            CHECK_EQUAL(frames.frame(i).length(), views[i].size());
+        }
+    }
+
     TEST(Duration)
     {
         // sampling at 100 Hz -> 10 miliseconds is 1 sample
@@ -155,4 +167,44 @@ SUITE(FramesCollection)
         std::size_t expected[2] = {5, 5};
         CHECK_ARRAY_EQUAL(expected, lengths, 2);
     }
+
+    TEST(ApplyFunctionObject)
+    {
+        struct FirstSample
+        {
+            Aquila::SampleType operator()(const Aquila::SignalSource& s) const
+            {
+                return s.sample(0);
+            }
+        };
+
+        Aquila::FramesCollection frames(data, 2);
+        auto firstSamples = frames.apply<Aquila::SampleType>(FirstSample());
+        Aquila::SampleType expected[5] = {0, 2, 4, 6, 8};
+        CHECK_ARRAY_EQUAL(expected, firstSamples, 5);
+    }
+
+    TEST(ParallelApply)
+    {
+        Aquila::FramesCollection frames(data, 2, 1);
+        auto serial = frames.apply<double>(Aquila::energy);
+        for (unsigned int threads = 0; threads <= 4; ++threads)
+        {
+            auto parallel = frames.parallelApply<double>(Aquila::energy, threads);
+            CHECK_EQUAL(serial.size(), parallel.size());
+            CHECK_ARRAY_EQUAL(serial, parallel, serial.size());
+        }
+    }
+
+    TEST(ParallelApplyLambda)
+    {
+        Aquila::FramesCollection frames(data, 5);
+        auto maximums = frames.parallelApply<Aquila::SampleType>(
+            [] (const Aquila::SignalSource& s) {
+                return *std::max_element(s.begin(), s.end());
+            }, 2
+        );
+        Aquila::SampleType expected[2] = {4.0, 9.0};
+        CHECK_ARRAY_CLOSE(expected, maximums, 2, 0.000001);
+    }
 }
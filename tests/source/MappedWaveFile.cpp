@@ -0,0 +1,115 @@
+#include "aquila/global.h"
+#include "aquila/Exceptions.h"
+#include "aquila/source/MappedWaveFile.h"
+#include "aquila/source/WaveFile.h"
+#include "constants.h"
+#include "UnitTest++/UnitTest++.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+SUITE(MappedWaveFile)
+{
+    TEST(Header)
+    {
+        Aquila::MappedWaveFile wav(Aquila_TEST_WAVEFILE_16B_STEREO);
+        CHECK_EQUAL(2, wav.getChannelsNum());
+        CHECK_EQUAL(16, wav.getBitsPerSample());
+        CHECK_EQUAL(44100, wav.getSampleFrequency());
+        CHECK_EQUAL(18208u, wav.getDataSize());
+        CHECK_EQUAL(4552u, wav.getFramesCount());
+    }
+
+    TEST(SameAsWaveFile16Bit)
+    {
+        Aquila::MappedWaveFile mapped(Aquila_TEST_WAVEFILE_16B_STEREO);
+        Aquila::WaveFile left(Aquila_TEST_WAVEFILE_16B_STEREO, Aquila::LEFT);
+        Aquila::WaveFile right(Aquila_TEST_WAVEFILE_16B_STEREO, Aquila::RIGHT);
+
+        const std::size_t count = mapped.getFramesCount();
+        auto mappedLeft = mapped.decode(0, count, 0);
+        auto mappedRight = mapped.decode(0, count, 1);
+        CHECK_ARRAY_EQUAL(left.toArray(), mappedLeft, count);
+        CHECK_ARRAY_EQUAL(right.toArray(), mappedRight, count);
+    }
+
+    TEST(DecodeRange)
+    {
+        Aquila::MappedWaveFile wav(Aquila_TEST_WAVEFILE_16B_MONO);
+        auto all = wav.decode(0, wav.getFramesCount());
+        auto part = wav.decode(1000, 250);
+        CHECK_ARRAY_EQUAL(&all[1000], part, 250);
+
+        const std::int16_t* raw = wav.getInt16Data();
+        CHECK_EQUAL(raw[1234], all[1234]);
+    }
+
+    TEST(Decode8Bit)
+    {
+        Aquila::MappedWaveFile wav(Aquila_TEST_WAVEFILE_8B_STEREO);
+        CHECK_EQUAL(2, wav.getChannelsNum());
+        auto right = wav.decode(0, 4, 1);
+        const unsigned char* raw = wav.getData();
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            CHECK_EQUAL(raw[2 * i + 1] - 128, right[i]);
+        }
+        CHECK_THROW(wav.getInt16Data(), Aquila::FormatException);
+    }
+
+    TEST(OutOfRange)
+    {
+        Aquila::MappedWaveFile wav(Aquila_TEST_WAVEFILE_16B_MONO);
+        const std::size_t count = wav.getFramesCount();
+        CHECK_THROW(wav.decode(0, 1, 1), Aquila::Exception);
+        CHECK_THROW(wav.decode(count - 1, 2, 0), Aquila::Exception);
+    }
+
+    TEST(SkipsOtherChunks)
+    {
+        Aquila::MappedWaveFile wav(Aquila_TEST_WAVEFILE_16B_CHUNKS);
+        CHECK_EQUAL(22050, wav.getSampleFrequency());
+        CHECK_EQUAL(4u, wav.getFramesCount());
+        auto left = wav.decode(0, 4, 0);
+        auto right = wav.decode(0, 4, 1);
+        Aquila::SampleType expectedLeft[4] = {10, 20, 30, 40};
+        Aquila::SampleType expectedRight[4] = {-10, -20, -30, -40};
+        CHECK_ARRAY_EQUAL(expectedLeft, left, 4);
+        CHECK_ARRAY_EQUAL(expectedRight, right, 4);
+    }
+
+    TEST(Extensible24Bit)
+    {
+        Aquila::MappedWaveFile wav(Aquila_TEST_WAVEFILE_24B_EXTENSIBLE);
+        CHECK_EQUAL(24, wav.getBitsPerSample());
+        CHECK_EQUAL(4u, wav.getFramesCount());
+        auto left = wav.decode(1, 3, 0);
+        Aquila::SampleType expected[3] = {-100000, 8388607, -8388608};
+        CHECK_ARRAY_EQUAL(expected, left, 3);
+        CHECK_THROW(wav.getInt16Data(), Aquila::FormatException);
+    }
+
+    TEST(PlanarDecode)
+    {
+        Aquila::MappedWaveFile wav(Aquila_TEST_WAVEFILE_16B_8CH);
+        CHECK_EQUAL(8, wav.getChannelsNum());
+        Aquila::SampleType first[3], sixth[3];
+        Aquila::SampleType* outputs[8] = {first, nullptr, nullptr, nullptr,
+                                          nullptr, sixth, nullptr, nullptr};
+        wav.decodeChannels(2, 3, outputs);
+        Aquila::SampleType expectedFirst[3] = {102, 103, 104};
+        Aquila::SampleType expectedSixth[3] = {-598, -597, -596};
+        CHECK_ARRAY_EQUAL(expectedFirst, first, 3);
+        CHECK_ARRAY_EQUAL(expectedSixth, sixth, 3);
+        CHECK_THROW(wav.decodeChannels(3, 3, outputs), Aquila::Exception);
+    }
+
+    TEST(NotAWaveFile)
+    {
+        CHECK_THROW(Aquila::MappedWaveFile wav(Aquila_TEST_TXTFILE),
+                    Aquila::FormatException);
+        CHECK_THROW(Aquila::MappedWaveFile wav("nonexistent.wav"),
+                    Aquila::Exception);
+    }
+}
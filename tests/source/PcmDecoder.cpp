@@ -0,0 +1,264 @@
+#include "aquila/global.h"
+#include "aquila/Exceptions.h"
+#include "aquila/source/PcmDecoder.h"
+#include "aquila/source/WaveHeader.h"
+#include "UnitTest++/UnitTest++.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+    template <typename T>
+    std::vector<unsigned char> toBytes(const std::vector<T>& values)
+    {
+        std::vector<unsigned char> bytes(values.size() * sizeof(T));
+        std::memcpy(bytes.data(), values.data(), bytes.size());
+        return bytes;
+    }
+
+    Aquila::WaveHeader makeHeader(std::uint16_t tag, std::uint16_t channels,
+                                  std::uint16_t bits)
+    {
+        Aquila::WaveHeader header;
+        header.formatTag = tag;
+        header.Channels = channels;
+        header.BitsPerSamp = bits;
+        header.BytesPerSamp = channels * bits / 8;
+        return header;
+    }
+}
+
+
+SUITE(PcmDecoder)
+{
+    TEST(Int24SignExtension)
+    {
+        const unsigned char data[] = {
+            0xA0, 0x86, 0x01,   // 100000
+            0x60, 0x79, 0xFE,   // -100000
+            0xFF, 0xFF, 0x7F,   // 8388607
+            0x00, 0x00, 0x80,   // -8388608
+            0xFF, 0xFF, 0xFF    // -1
+        };
+        Aquila::SampleType output[5];
+        Aquila::PcmDecoder::decode(Aquila::PcmDecoder::Int24, data, 5, 1, 0, output);
+        Aquila::SampleType expected[5] = {100000, -100000, 8388607, -8388608, -1};
+        CHECK_ARRAY_EQUAL(expected, output, 5);
+    }
+
+    TEST(Int16Mono)
+    {
+        // long enough to cover both the vector loop and the tail
+        std::vector<std::int16_t> values;
+        for (int i = 0; i < 21; ++i)
+        {
+            values.push_back(static_cast<std::int16_t>((i - 10) * 3000));
+        }
+        auto bytes = toBytes(values);
+        std::vector<Aquila::SampleType> output(values.size());
+        Aquila::PcmDecoder::decode(Aquila::PcmDecoder::Int16, bytes.data(),
+                                   values.size(), 1, 0, output.data());
+        CHECK_ARRAY_EQUAL(values, output, values.size());
+    }
+
+    TEST(Int32Mono)
+    {
+        std::vector<std::int32_t> values{2147483647, -2147483647 - 1, 0, 5,
+                                         -123456789, 42, -1};
+        auto bytes = toBytes(values);
+        std::vector<Aquila::SampleType> output(values.size());
+        Aquila::PcmDecoder::decode(Aquila::PcmDecoder::Int32, bytes.data(),
+                                   values.size(), 1, 0, output.data());
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            CHECK_CLOSE(static_cast<double>(values[i]), output[i],
+                        1e-7 * 2147483648.0);
+        }
+    }
+
+    TEST(Float32Mono)
+    {
+        std::vector<float> values{0.0f, 0.5f, -0.5f, 1.0f, -1.0f, 0.25f};
+        auto bytes = toBytes(values);
+        std::vector<Aquila::SampleType> output(values.size());
+        Aquila::PcmDecoder::decode(Aquila::PcmDecoder::Float32, bytes.data(),
+                                   values.size(), 1, 0, output.data());
+        CHECK_ARRAY_EQUAL(values, output, values.size());
+    }
+
+    TEST(Float64Stereo)
+    {
+        std::vector<double> values{0.5, -0.5, 0.25, -0.25, 0.125, -0.125};
+        auto bytes = toBytes(values);
+        Aquila::SampleType left[3], right[3];
+        Aquila::PcmDecoder::decode(Aquila::PcmDecoder::Float64, bytes.data(),
+                                   3, 2, 0, left);
+        Aquila::PcmDecoder::decode(Aquila::PcmDecoder::Float64, bytes.data(),
+                                   3, 2, 1, right);
+        Aquila::SampleType expectedLeft[3] = {0.5, 0.25, 0.125};
+        Aquila::SampleType expectedRight[3] = {-0.5, -0.25, -0.125};
+        CHECK_ARRAY_EQUAL(expectedLeft, left, 3);
+        CHECK_ARRAY_EQUAL(expectedRight, right, 3);
+    }
+
+    TEST(UInt8ChannelSelection)
+    {
+        const unsigned char data[] = {128, 0, 255, 130, 126, 1};
+        Aquila::SampleType output[2];
+        Aquila::PcmDecoder::decode(Aquila::PcmDecoder::UInt8, data, 2, 3, 2, output);
+        Aquila::SampleType expected[2] = {127, -127};
+        CHECK_ARRAY_EQUAL(expected, output, 2);
+    }
+
+    TEST(Deinterleave)
+    {
+        // 3 channels of 24-bit samples, the middle one skipped
+        const unsigned char data[] = {
+            0x01, 0x00, 0x00,  0x02, 0x00, 0x00,  0xFF, 0xFF, 0xFF,
+            0x03, 0x00, 0x00,  0x04, 0x00, 0x00,  0xFE, 0xFF, 0xFF
+        };
+        Aquila::SampleType first[2], third[2];
+        Aquila::SampleType* outputs[3] = {first, nullptr, third};
+        Aquila::PcmDecoder::deinterleave(Aquila::PcmDecoder::Int24, data, 2, 3,
+                                         outputs);
+        Aquila::SampleType expectedFirst[2] = {1, 3};
+        Aquila::SampleType expectedThird[2] = {-1, -2};
+        CHECK_ARRAY_EQUAL(expectedFirst, first, 2);
+        CHECK_ARRAY_EQUAL(expectedThird, third, 2);
+    }
+
+    TEST(KernelName)
+    {
+        const std::string name = Aquila::PcmDecoder::getKernelName();
+        CHECK(name == "avx2" || name == "sse2" || name == "neon" ||
+              name == "scalar");
+    }
+
+    TEST(Int16StereoKernel)
+    {
+        // odd lengths cover the vector loops and their scalar tails
+        const std::size_t frames = 37;
+        std::vector<std::int16_t> values;
+        for (std::size_t i = 0; i < frames; ++i)
+        {
+            values.push_back(static_cast<std::int16_t>(i * 1771 - 32768));
+            values.push_back(static_cast<std::int16_t>(32767 - i * 913));
+        }
+        auto bytes = toBytes(values);
+        std::vector<Aquila::SampleType> left(frames), right(frames);
+        Aquila::SampleType* outputs[2] = {left.data(), right.data()};
+        Aquila::PcmDecoder::deinterleave(Aquila::PcmDecoder::Int16, bytes.data(),
+                                         frames, 2, outputs);
+        for (std::size_t i = 0; i < frames; ++i)
+        {
+            CHECK_EQUAL(values[2 * i], left[i]);
+            CHECK_EQUAL(values[2 * i + 1], right[i]);
+        }
+    }
+
+    TEST(UInt8Kernels)
+    {
+        const std::size_t count = 75;
+        std::vector<unsigned char> data;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            data.push_back(static_cast<unsigned char>(i * 37));
+        }
+        std::vector<Aquila::SampleType> mono(count);
+        Aquila::PcmDecoder::decode(Aquila::PcmDecoder::UInt8, data.data(),
+                                   count, 1, 0, mono.data());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            CHECK_EQUAL(data[i] - 128, mono[i]);
+        }
+
+        const std::size_t frames = count / 2;
+        std::vector<Aquila::SampleType> left(frames), right(frames);
+        Aquila::SampleType* outputs[2] = {left.data(), right.data()};
+        Aquila::PcmDecoder::deinterleave(Aquila::PcmDecoder::UInt8, data.data(),
+                                         frames, 2, outputs);
+        for (std::size_t i = 0; i < frames; ++i)
+        {
+            CHECK_EQUAL(data[2 * i] - 128, left[i]);
+            CHECK_EQUAL(data[2 * i + 1] - 128, right[i]);
+        }
+    }
+
+    TEST(LargeBuffer)
+    {
+        // big enough to be split between threads
+        const std::size_t frames = (1 << 19) + 5;
+        std::vector<std::int16_t> values(2 * frames);
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            values[i] = static_cast<std::int16_t>(i * 7);
+        }
+        auto bytes = toBytes(values);
+        std::vector<Aquila::SampleType> left(frames), right(frames);
+        Aquila::SampleType* outputs[2] = {left.data(), right.data()};
+        Aquila::PcmDecoder::deinterleave(Aquila::PcmDecoder::Int16, bytes.data(),
+                                         frames, 2, outputs);
+        std::size_t mismatches = 0;
+        for (std::size_t i = 0; i < frames; ++i)
+        {
+            if (values[2 * i] != left[i] || values[2 * i + 1] != right[i])
+                ++mismatches;
+        }
+        CHECK_EQUAL(0u, mismatches);
+    }
+
+    TEST(Encodings)
+    {
+        using Aquila::PcmDecoder;
+        CHECK_EQUAL(PcmDecoder::UInt8, PcmDecoder::getEncoding(makeHeader(1, 2, 8)));
+        CHECK_EQUAL(PcmDecoder::Int16, PcmDecoder::getEncoding(makeHeader(1, 1, 16)));
+        CHECK_EQUAL(PcmDecoder::Int24, PcmDecoder::getEncoding(makeHeader(1, 2, 24)));
+        CHECK_EQUAL(PcmDecoder::Int32, PcmDecoder::getEncoding(makeHeader(1, 1, 32)));
+        CHECK_EQUAL(PcmDecoder::Float32, PcmDecoder::getEncoding(makeHeader(3, 1, 32)));
+        CHECK_EQUAL(PcmDecoder::Float64, PcmDecoder::getEncoding(makeHeader(3, 2, 64)));
+        CHECK_EQUAL(3u, PcmDecoder::getSampleSize(PcmDecoder::Int24));
+    }
+
+    TEST(UnsupportedEncodings)
+    {
+        using Aquila::PcmDecoder;
+        // A-law, 16-bit float, 12-bit and broken block alignment
+        CHECK_THROW(PcmDecoder::getEncoding(makeHeader(6, 1, 8)),
+                    Aquila::FormatException);
+        CHECK_THROW(PcmDecoder::getEncoding(makeHeader(3, 1, 16)),
+                    Aquila::FormatException);
+        CHECK_THROW(PcmDecoder::getEncoding(makeHeader(1, 1, 12)),
+                    Aquila::FormatException);
+        Aquila::WaveHeader header = makeHeader(1, 2, 16);
+        header.BytesPerSamp = 3;
+        CHECK_THROW(PcmDecoder::getEncoding(header), Aquila::FormatException);
+    }
+
+    TEST(ExtensibleFormatChunk)
+    {
+        const unsigned char body[40] = {
+            0xFE, 0xFF, 0x02, 0x00,             // extensible, 2 channels
+            0x80, 0xBB, 0x00, 0x00,             // 48000 Hz
+            0x00, 0xDC, 0x05, 0x00,             // 384000 bytes/s
+            0x08, 0x00, 0x20, 0x00,             // 8 bytes/frame, 32 bits
+            0x16, 0x00, 0x20, 0x00,             // cbSize, valid bits
+            0x03, 0x00, 0x00, 0x00,             // channel mask
+            0x03, 0x00, 0x00, 0x00, 0x00, 0x00, // IEEE float sub-format
+            0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71
+        };
+        Aquila::WaveHeader header;
+        Aquila::PcmDecoder::readFormatChunk(body, sizeof(body), header);
+        CHECK_EQUAL(Aquila::PcmDecoder::FORMAT_IEEE_FLOAT, header.formatTag);
+        CHECK_EQUAL(2, header.Channels);
+        CHECK_EQUAL(48000u, header.SampFreq);
+        CHECK_EQUAL(Aquila::PcmDecoder::Float32,
+                    Aquila::PcmDecoder::getEncoding(header));
+
+        CHECK_THROW(Aquila::PcmDecoder::readFormatChunk(body, 14, header),
+                    Aquila::FormatException);
+    }
+}
@@ -1,4 +1,5 @@
 #include "aquila/global.h"
+#include "aquila/Exceptions.h"
 #include "aquila/source/SignalSource.h"
 #include "aquila/source/WaveFile.h"
 #include "aquila/source/FramesCollection.h"
@@ -6,6 +7,7 @@
 #include "UnitTest++/UnitTest++.h"
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -210,6 +212,42 @@ SUITE(WaveFile)
         CHECK_EQUAL(inputWav.getSamplesCount(), wav.getSamplesCount());
     }
 
+    TEST(Save8bitSamples)
+    {
+        Aquila::WaveFile inputWav(Aquila_TEST_WAVEFILE_8B_MONO);
+        Aquila::WaveFile::save(inputWav, Aquila_TEST_WAVEFILE_OUTPUT);
+
+        Aquila::WaveFile wav(Aquila_TEST_WAVEFILE_OUTPUT);
+        CHECK_ARRAY_EQUAL(inputWav.toArray(), wav.toArray(),
+                          inputWav.getSamplesCount());
+    }
+
+    TEST(Save8bitOddLength)
+    {
+        Aquila::WaveFile inputWav(Aquila_TEST_WAVEFILE_8B_ODD);
+        CHECK_EQUAL(5u, inputWav.getSamplesCount());
+        Aquila::WaveFile::save(inputWav, Aquila_TEST_WAVEFILE_OUTPUT);
+
+        Aquila::WaveFile wav(Aquila_TEST_WAVEFILE_OUTPUT);
+        CHECK_EQUAL(8, wav.getBitsPerSample());
+        CHECK_EQUAL(5u, wav.getSamplesCount());
+        Aquila::SampleType expected[5] = {-128, 127, 0, -127, 72};
+        CHECK_ARRAY_EQUAL(expected, wav.toArray(), 5);
+    }
+
+    TEST(Decode8bitStereo)
+    {
+        unsigned char bytes[6] = {128, 0, 255, 130, 1, 129};
+        short data[3];
+        std::memcpy(data, bytes, sizeof(data));
+        Aquila::ChannelType left(3), right(3);
+        Aquila::WaveFileHandler::decode8bitStereo(left, right, data, 3);
+        Aquila::SampleType expectedLeft[3] = {0, 127, -127};
+        Aquila::SampleType expectedRight[3] = {-128, 2, 1};
+        CHECK_ARRAY_EQUAL(expectedLeft, left, 3);
+        CHECK_ARRAY_EQUAL(expectedRight, right, 3);
+    }
+
     TEST(Save16bit)
     {
         Aquila::WaveFile inputWav(Aquila_TEST_WAVEFILE_16B_MONO);
@@ -237,4 +275,102 @@ SUITE(WaveFile)
             CHECK_EQUAL(testArray[i], wav.sample(i));
         }
     }
+
+    TEST(SkipsOtherChunks)
+    {
+        Aquila::WaveFile left(Aquila_TEST_WAVEFILE_16B_CHUNKS);
+        Aquila::WaveFile right(Aquila_TEST_WAVEFILE_16B_CHUNKS, Aquila::RIGHT);
+        CHECK_EQUAL(22050, left.getSampleFrequency());
+        CHECK_EQUAL(16u, left.getWaveSize());
+        CHECK_EQUAL(4u, left.getSamplesCount());
+        Aquila::SampleType expectedLeft[4] = {10, 20, 30, 40};
+        Aquila::SampleType expectedRight[4] = {-10, -20, -30, -40};
+        CHECK_ARRAY_EQUAL(expectedLeft, left.toArray(), 4);
+        CHECK_ARRAY_EQUAL(expectedRight, right.toArray(), 4);
+    }
+
+    TEST(ChunkIndex)
+    {
+        Aquila::WaveHeader header;
+        Aquila::WaveFileHandler handler(Aquila_TEST_WAVEFILE_16B_CHUNKS);
+        handler.readHeader(header);
+
+        const char* ids[5] = {"JUNK", "fmt ", "LIST", "data", "id3 "};
+        const auto& chunks = handler.getChunks();
+        CHECK_EQUAL(5u, chunks.size());
+        for (std::size_t i = 0; i < chunks.size() && i < 5; ++i)
+        {
+            CHECK(std::equal(ids[i], ids[i] + 4, chunks[i].id));
+        }
+        CHECK_EQUAL(18u, header.SubBlockLength);
+
+        const Aquila::WaveChunk* data = handler.findChunk("data");
+        CHECK(data != nullptr);
+        CHECK_EQUAL(88u, data->offset);
+        CHECK_EQUAL(16u, data->size);
+        CHECK(handler.findChunk("bext") == nullptr);
+    }
+
+    TEST(NotAWaveFile)
+    {
+        Aquila::WaveHeader header;
+        Aquila::WaveFileHandler handler(Aquila_TEST_TXTFILE);
+        CHECK_THROW(handler.readHeader(header), Aquila::FormatException);
+    }
+
+    TEST(Extensible24Bit)
+    {
+        Aquila::WaveFile left(Aquila_TEST_WAVEFILE_24B_EXTENSIBLE, Aquila::LEFT);
+        Aquila::WaveFile right(Aquila_TEST_WAVEFILE_24B_EXTENSIBLE, Aquila::RIGHT);
+        CHECK_EQUAL(24, left.getBitsPerSample());
+        CHECK_EQUAL(48000, left.getSampleFrequency());
+        CHECK_EQUAL(4u, left.getSamplesCount());
+        Aquila::SampleType expectedLeft[4] = {100000, -100000, 8388607, -8388608};
+        Aquila::SampleType expectedRight[4] = {1, -1, 0, 42};
+        CHECK_ARRAY_EQUAL(expectedLeft, left.toArray(), 4);
+        CHECK_ARRAY_EQUAL(expectedRight, right.toArray(), 4);
+    }
+
+    TEST(MultiChannelMask)
+    {
+        Aquila::WaveHeader header;
+        Aquila::WaveFileHandler handler(Aquila_TEST_WAVEFILE_16B_8CH);
+        std::vector<Aquila::ChannelType> channels;
+        handler.readHeaderAndChannels(header, channels, 0xA4);
+
+        CHECK_EQUAL(8u, channels.size());
+        for (std::size_t c = 0; c < channels.size(); ++c)
+        {
+            const bool selected = (0xA4 >> c) & 1;
+            CHECK_EQUAL(selected ? 5u : 0u, channels[c].size());
+        }
+        Aquila::SampleType expected2[5] = {300, 301, 302, 303, 304};
+        Aquila::SampleType expected7[5] = {-800, -799, -798, -797, -796};
+        CHECK_ARRAY_EQUAL(expected2, channels[2], 5);
+        CHECK_ARRAY_EQUAL(expected7, channels[7], 5);
+    }
+
+    TEST(MultiChannelRight)
+    {
+        Aquila::WaveFile wav(Aquila_TEST_WAVEFILE_16B_8CH, Aquila::RIGHT);
+        CHECK_EQUAL(8, wav.getChannelsNum());
+        CHECK_EQUAL(5u, wav.getSamplesCount());
+        Aquila::SampleType expected[5] = {-200, -199, -198, -197, -196};
+        CHECK_ARRAY_EQUAL(expected, wav.toArray(), 5);
+    }
+
+    TEST(MultiChannelParts)
+    {
+        // 3 frames of 16 bytes each, the remainder is not a whole frame
+        Aquila::WaveFile wav(Aquila_TEST_WAVEFILE_16B_8CH, 50);
+        auto first = wav.load_next();
+        auto second = wav.load_next();
+        CHECK_EQUAL(8u, first.size());
+        CHECK_EQUAL(8u, second.size());
+        CHECK_EQUAL(3u, first[0].size());
+        CHECK_EQUAL(2u, second[0].size());
+        CHECK_EQUAL(100, first[0][0]);
+        CHECK_EQUAL(-397, second[3][0]);
+        CHECK_EQUAL(704, second[6][1]);
+    }
 }
@@ -22,6 +22,22 @@ SUITE(AquilaFft)
         constSpectrumTest<Aquila::AquilaFft, 1024>();
     }
 
+    TEST(DeltaInverse)
+    {
+        deltaInverseTest<Aquila::AquilaFft, 8>();
+        deltaInverseTest<Aquila::AquilaFft, 16>();
+        deltaInverseTest<Aquila::AquilaFft, 128>();
+        deltaInverseTest<Aquila::AquilaFft, 1024>();
+    }
+
+    TEST(ConstInverse)
+    {
+        constInverseTest<Aquila::AquilaFft, 8>();
+        constInverseTest<Aquila::AquilaFft, 16>();
+        constInverseTest<Aquila::AquilaFft, 128>();
+        constInverseTest<Aquila::AquilaFft, 1024>();
+    }
+
     TEST(Identity)
     {
         identityTest<Aquila::AquilaFft, 8>();
@@ -29,4 +45,38 @@ SUITE(AquilaFft)
         identityTest<Aquila::AquilaFft, 128>();
         identityTest<Aquila::AquilaFft, 1024>();
     }
+
+    TEST(RealSpectrum)
+    {
+        realSpectrumTest<Aquila::AquilaFft, 8>();
+        realSpectrumTest<Aquila::AquilaFft, 16>();
+        realSpectrumTest<Aquila::AquilaFft, 128>();
+        realSpectrumTest<Aquila::AquilaFft, 1024>();
+    }
+
+    TEST(RealIdentity)
+    {
+        realIdentityTest<Aquila::AquilaFft, 8>();
+        realIdentityTest<Aquila::AquilaFft, 16>();
+        realIdentityTest<Aquila::AquilaFft, 128>();
+        realIdentityTest<Aquila::AquilaFft, 1024>();
+    }
+
+    TEST(NoAllocations)
+    {
+        noAllocationTest<Aquila::AquilaFft, 8>();
+        noAllocationTest<Aquila::AquilaFft, 128>();
+        noAllocationTest<Aquila::AquilaFft, 1024>();
+    }
+
+    TEST(LengthOne)
+    {
+        lengthOneTest<Aquila::AquilaFft>();
+    }
+
+    TEST(Batch)
+    {
+        batchTest<Aquila::AquilaFft, 8, 3>();
+        batchTest<Aquila::AquilaFft, 1024, 80>();
+    }
 }
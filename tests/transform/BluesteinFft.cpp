@@ -0,0 +1,101 @@
+#include "Fft.h"
+#include "aquila/global.h"
+#include "aquila/transform/BluesteinFft.h"
+#include "UnitTest++/UnitTest++.h"
+
+
+SUITE(BluesteinFft)
+{
+    TEST(Delta)
+    {
+        deltaSpectrumTest<Aquila::BluesteinFft, 7>();
+        deltaSpectrumTest<Aquila::BluesteinFft, 13>();
+        deltaSpectrumTest<Aquila::BluesteinFft, 401>();
+        deltaSpectrumTest<Aquila::BluesteinFft, 1024>();
+    }
+
+    TEST(ConstSignal)
+    {
+        constSpectrumTest<Aquila::BluesteinFft, 7>();
+        constSpectrumTest<Aquila::BluesteinFft, 13>();
+        constSpectrumTest<Aquila::BluesteinFft, 401>();
+        constSpectrumTest<Aquila::BluesteinFft, 1024>();
+    }
+
+    TEST(ReferenceSpectrum)
+    {
+        referenceSpectrumTest<Aquila::BluesteinFft, 1>();
+        referenceSpectrumTest<Aquila::BluesteinFft, 2>();
+        referenceSpectrumTest<Aquila::BluesteinFft, 3>();
+        referenceSpectrumTest<Aquila::BluesteinFft, 11>();
+        referenceSpectrumTest<Aquila::BluesteinFft, 13>();
+        referenceSpectrumTest<Aquila::BluesteinFft, 17>();
+        referenceSpectrumTest<Aquila::BluesteinFft, 97>();
+        referenceSpectrumTest<Aquila::BluesteinFft, 121>();
+        referenceSpectrumTest<Aquila::BluesteinFft, 401>();
+        referenceSpectrumTest<Aquila::BluesteinFft, 1000>();
+    }
+
+    TEST(DeltaInverse)
+    {
+        deltaInverseTest<Aquila::BluesteinFft, 7>();
+        deltaInverseTest<Aquila::BluesteinFft, 13>();
+        deltaInverseTest<Aquila::BluesteinFft, 401>();
+        deltaInverseTest<Aquila::BluesteinFft, 1024>();
+    }
+
+    TEST(ConstInverse)
+    {
+        constInverseTest<Aquila::BluesteinFft, 7>();
+        constInverseTest<Aquila::BluesteinFft, 13>();
+        constInverseTest<Aquila::BluesteinFft, 401>();
+        constInverseTest<Aquila::BluesteinFft, 1024>();
+    }
+
+    TEST(Identity)
+    {
+        identityTest<Aquila::BluesteinFft, 7>();
+        identityTest<Aquila::BluesteinFft, 13>();
+        identityTest<Aquila::BluesteinFft, 401>();
+        identityTest<Aquila::BluesteinFft, 1024>();
+    }
+
+    TEST(RealSpectrum)
+    {
+        realSpectrumTest<Aquila::BluesteinFft, 7>();
+        realSpectrumTest<Aquila::BluesteinFft, 13>();
+        realSpectrumTest<Aquila::BluesteinFft, 401>();
+        realSpectrumTest<Aquila::BluesteinFft, 1024>();
+    }
+
+    TEST(RealIdentity)
+    {
+        realIdentityTest<Aquila::BluesteinFft, 1>();
+        realIdentityTest<Aquila::BluesteinFft, 2>();
+        realIdentityTest<Aquila::BluesteinFft, 3>();
+        realIdentityTest<Aquila::BluesteinFft, 11>();
+        realIdentityTest<Aquila::BluesteinFft, 13>();
+        realIdentityTest<Aquila::BluesteinFft, 17>();
+        realIdentityTest<Aquila::BluesteinFft, 97>();
+        realIdentityTest<Aquila::BluesteinFft, 121>();
+        realIdentityTest<Aquila::BluesteinFft, 401>();
+        realIdentityTest<Aquila::BluesteinFft, 1000>();
+    }
+
+    TEST(NoAllocations)
+    {
+        noAllocationTest<Aquila::BluesteinFft, 401>();
+        noAllocationTest<Aquila::BluesteinFft, 1024>();
+    }
+
+    TEST(LengthOne)
+    {
+        lengthOneTest<Aquila::BluesteinFft>();
+    }
+
+    TEST(Batch)
+    {
+        batchTest<Aquila::BluesteinFft, 13, 3>();
+        batchTest<Aquila::BluesteinFft, 401, 40>();
+    }
+}
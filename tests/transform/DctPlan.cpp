@@ -0,0 +1,173 @@
+#include "aquila/global.h"
+#include "aquila/transform/Dct.h"
+#include "aquila/transform/DctPlan.h"
+#include "UnitTest++/UnitTest++.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * Returns a test signal of given length.
+ */
+static std::vector<double> dctTestSignal(std::size_t length)
+{
+    std::vector<double> data(length);
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        data[i] = std::sin(0.3 * i) + 0.25 * std::cos(1.7 * i) + 0.01 * i;
+    }
+    return data;
+}
+
+/**
+ * Directly evaluates the orthonormal DCT-II definition.
+ */
+static std::vector<double> referenceDct(const std::vector<double>& data,
+                                        std::size_t outputLength)
+{
+    const std::size_t N = data.size();
+    std::vector<double> output(outputLength, 0.0);
+    for (std::size_t n = 0; n < outputLength; ++n)
+    {
+        for (std::size_t k = 0; k < N; ++k)
+        {
+            output[n] += data[k] * std::cos(M_PI * (2 * k + 1) * n / (2.0 * N));
+        }
+        output[n] *= std::sqrt((0 == n ? 1.0 : 2.0) / N);
+    }
+    return output;
+}
+
+/**
+ * Checks a plan against the reference DCT.
+ */
+static void dctPlanTest(std::size_t inputLength, std::size_t outputLength,
+                        Aquila::DctPlan::Method method)
+{
+    auto data = dctTestSignal(inputLength);
+    auto expected = referenceDct(data, outputLength);
+
+    Aquila::DctPlan plan(inputLength, outputLength, method);
+    auto output = plan.dct(data);
+
+    CHECK_EQUAL(outputLength, output.size());
+    CHECK_ARRAY_CLOSE(expected, output, outputLength, 0.0001);
+}
+
+
+SUITE(DctPlan)
+{
+    TEST(AlternatingOnes)
+    {
+        const std::size_t SIZE = 4;
+        const double testArray[SIZE] = {1.0, -1.0, 1.0, -1.0};
+
+        Aquila::DctPlan plan(SIZE, SIZE);
+        double output[SIZE];
+        plan.dct(testArray, output);
+
+        double expected[SIZE] = {0.0, 0.76536686, 0.0, 1.84775907};
+        CHECK_ARRAY_CLOSE(expected, output, SIZE, 0.0001);
+    }
+
+    TEST(MatrixFewCoefficients)
+    {
+        dctPlanTest(26, 13, Aquila::DctPlan::MatrixMethod);
+    }
+
+    TEST(MatrixOddLength)
+    {
+        dctPlanTest(23, 23, Aquila::DctPlan::MatrixMethod);
+    }
+
+    TEST(MatrixMoreOutputsThanInputs)
+    {
+        dctPlanTest(5, 8, Aquila::DctPlan::MatrixMethod);
+    }
+
+    TEST(FftPowerOf2)
+    {
+        dctPlanTest(64, 64, Aquila::DctPlan::FftMethod);
+    }
+
+    TEST(FftEvenLength)
+    {
+        dctPlanTest(40, 20, Aquila::DctPlan::FftMethod);
+    }
+
+    TEST(FftOddLength)
+    {
+        dctPlanTest(45, 45, Aquila::DctPlan::FftMethod);
+    }
+
+    TEST(FftPrimeLength)
+    {
+        dctPlanTest(37, 37, Aquila::DctPlan::FftMethod);
+    }
+
+    TEST(DefaultMethod)
+    {
+        Aquila::DctPlan fewCoefficients(256, 13);
+        CHECK_EQUAL(Aquila::DctPlan::MatrixMethod, fewCoefficients.getMethod());
+
+        Aquila::DctPlan allCoefficients(256, 256);
+        CHECK_EQUAL(Aquila::DctPlan::FftMethod, allCoefficients.getMethod());
+
+        Aquila::DctPlan primeLength(251, 251);
+        CHECK_EQUAL(Aquila::DctPlan::MatrixMethod, primeLength.getMethod());
+
+        Aquila::DctPlan moreOutputs(40, 80, Aquila::DctPlan::FftMethod);
+        CHECK_EQUAL(Aquila::DctPlan::MatrixMethod, moreOutputs.getMethod());
+    }
+
+    TEST(SameAsDct)
+    {
+        auto data = dctTestSignal(40);
+
+        Aquila::Dct dct;
+        auto expected = dct.dct(data, 12);
+
+        Aquila::DctPlan plan(40, 12);
+        auto output = plan.dct(data);
+
+        CHECK_ARRAY_CLOSE(expected, output, 12, 0.000001);
+    }
+
+    TEST(ConcurrentTransforms)
+    {
+        const std::size_t SIZE = 128, THREADS = 4;
+        auto data = dctTestSignal(SIZE);
+        auto expected = referenceDct(data, SIZE);
+        const Aquila::DctPlan matrixPlan(SIZE, SIZE, Aquila::DctPlan::MatrixMethod);
+        const Aquila::DctPlan fftPlan(SIZE, SIZE, Aquila::DctPlan::FftMethod);
+
+        std::vector<double> errors(THREADS, 0.0);
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < THREADS; ++t)
+        {
+            threads.push_back(std::thread([&, t] () {
+                const Aquila::DctPlan& plan = (t % 2) ? fftPlan : matrixPlan;
+                for (int repeat = 0; repeat < 50; ++repeat)
+                {
+                    auto output = plan.dct(data);
+                    for (std::size_t i = 0; i < SIZE; ++i)
+                    {
+                        double error = std::abs(output[i] - expected[i]);
+                        errors[t] = std::max(errors[t], error);
+                    }
+                }
+            }));
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (std::size_t t = 0; t < THREADS; ++t)
+        {
+            CHECK_CLOSE(0.0, errors[t], 0.0001);
+        }
+    }
+}
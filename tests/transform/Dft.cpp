@@ -45,4 +45,38 @@ SUITE(Dft)
         identityTest<Aquila::Dft, 128>();
         identityTest<Aquila::Dft, 1024>();
     }
+
+    TEST(RealSpectrum)
+    {
+        realSpectrumTest<Aquila::Dft, 8>();
+        realSpectrumTest<Aquila::Dft, 16>();
+        realSpectrumTest<Aquila::Dft, 128>();
+        realSpectrumTest<Aquila::Dft, 1024>();
+    }
+
+    TEST(RealIdentity)
+    {
+        realIdentityTest<Aquila::Dft, 8>();
+        realIdentityTest<Aquila::Dft, 16>();
+        realIdentityTest<Aquila::Dft, 128>();
+        realIdentityTest<Aquila::Dft, 1024>();
+    }
+
+    TEST(NoAllocations)
+    {
+        noAllocationTest<Aquila::Dft, 8>();
+        noAllocationTest<Aquila::Dft, 128>();
+        noAllocationTest<Aquila::Dft, 1024>();
+    }
+
+    TEST(LengthOne)
+    {
+        lengthOneTest<Aquila::Dft>();
+    }
+
+    TEST(Batch)
+    {
+        batchTest<Aquila::Dft, 8, 3>();
+        batchTest<Aquila::Dft, 16, 5>();
+    }
 }
@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <cstddef>
 #include <iterator>
+#include <thread>
+#include <vector>
 
 unsigned int findPeak(std::size_t arraySize,
                       Aquila::FrequencyType sampleFrequency,
@@ -104,4 +106,102 @@ SUITE(Fft)
         unsigned int peakPosition = findPeak(1024, 44100, 21204);
         CHECK_EQUAL(492u, peakPosition);
     }
+
+    TEST(FactoryBackends)
+    {
+        const std::size_t SIZE = 64;
+        Aquila::SampleType testArray[SIZE];
+        for (std::size_t i = 0; i < SIZE; ++i)
+        {
+            testArray[i] = static_cast<double>(i % 7) - 3.0;
+        }
+
+        auto expected = Aquila::FftFactory::getFft(SIZE)->fft(testArray);
+        Aquila::FftFactory::Backend backends[] = {
+            Aquila::FftFactory::AquilaBackend,
+            Aquila::FftFactory::OouraBackend,
+            Aquila::FftFactory::Radix4Backend
+        };
+        for (auto backend : backends)
+        {
+            auto fft = Aquila::FftFactory::getFft(SIZE, backend);
+            CHECK_EQUAL(SIZE, fft->getLength());
+            auto spectrum = fft->fft(testArray);
+            for (std::size_t i = 0; i < SIZE; ++i)
+            {
+                CHECK_CLOSE(expected[i].real(), spectrum[i].real(), 0.0001);
+                CHECK_CLOSE(expected[i].imag(), spectrum[i].imag(), 0.0001);
+            }
+        }
+    }
+
+    TEST(FactoryCache)
+    {
+        auto fft1 = Aquila::FftFactory::getFft(256);
+        auto fft2 = Aquila::FftFactory::getFft(256);
+        auto fft3 = Aquila::FftFactory::getFft(
+            256, Aquila::FftFactory::Radix4Backend);
+        CHECK(fft1 == fft2);
+        CHECK(fft1 != fft3);
+
+        Aquila::FftFactory::clearCache();
+        auto fft4 = Aquila::FftFactory::getFft(256);
+        CHECK(fft1 != fft4);
+        CHECK_EQUAL(256u, fft1->getLength());
+    }
+
+    TEST(ConcurrentTransforms)
+    {
+        const std::size_t SIZE = 400;
+        const std::size_t THREADS = 4;
+        Aquila::SampleType testArray[SIZE];
+        for (std::size_t i = 0; i < SIZE; ++i)
+        {
+            testArray[i] = static_cast<double>(i % 9) - 4.0;
+        }
+
+        Aquila::FftFactory::Backend backends[] = {
+            Aquila::FftFactory::DefaultBackend,
+            Aquila::FftFactory::AquilaBackend,
+            Aquila::FftFactory::OouraBackend,
+            Aquila::FftFactory::Radix4Backend,
+            Aquila::FftFactory::BluesteinBackend
+        };
+        for (auto backend : backends)
+        {
+            // power of 2 backends get a power of 2 length
+            const bool anyLength =
+                backend == Aquila::FftFactory::DefaultBackend ||
+                backend == Aquila::FftFactory::BluesteinBackend;
+            const std::size_t length = anyLength ? SIZE : 256;
+            auto fft = Aquila::FftFactory::getFft(length, backend);
+            auto expected = fft->fft(testArray);
+
+            std::vector<double> errors(THREADS, 0.0);
+            std::vector<std::thread> threads;
+            for (std::size_t t = 0; t < THREADS; ++t)
+            {
+                threads.emplace_back([&, t] {
+                    std::vector<Aquila::ComplexType> spectrum(length);
+                    for (int run = 0; run < 50; ++run)
+                    {
+                        fft->fft(testArray, &spectrum[0]);
+                        for (std::size_t i = 0; i < length; ++i)
+                        {
+                            double error = std::abs(spectrum[i] - expected[i]);
+                            errors[t] = std::max(errors[t], error);
+                        }
+                    }
+                });
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            for (std::size_t t = 0; t < THREADS; ++t)
+            {
+                CHECK_CLOSE(0.0, errors[t], 0.000001);
+            }
+        }
+    }
 }
@@ -7,9 +7,24 @@
 
 #include "aquila/global.h"
 #include "aquila/transform/AquilaFft.h"
+#include "aquila/transform/Dft.h"
+#include "../AllocationCounter.h"
 #include "UnitTest++/UnitTest++.h"
 #include <algorithm>
 #include <cstddef>
+#include <vector>
+
+/**
+ * Absolute tolerance of spectrum and signal comparisons.
+ *
+ * Spectra of the test signals reach thousands, so single precision
+ * builds need a looser bound.
+ */
+#ifdef AQUILA_USE_FLOAT
+const double FFT_TOLERANCE = 0.01;
+#else
+const double FFT_TOLERANCE = 0.0001;
+#endif
 
 /**
  * Test that spectrum of a delta signal is constant.
@@ -31,7 +46,7 @@ void deltaSpectrumTest()
 
     double expected[SIZE];
     std::fill_n(expected, SIZE, 1.0);
-    CHECK_ARRAY_CLOSE(expected, absSpectrum, SIZE, 0.0001);
+    CHECK_ARRAY_CLOSE(expected, absSpectrum, SIZE, FFT_TOLERANCE);
 }
 
 /**
@@ -54,7 +69,7 @@ void constSpectrumTest()
     // expecting a delta scaled by SIZE
     double expected[SIZE] = {0};
     expected[0] = SIZE * 1.0;
-    CHECK_ARRAY_CLOSE(expected, absSpectrum, SIZE, 0.0001);
+    CHECK_ARRAY_CLOSE(expected, absSpectrum, SIZE, FFT_TOLERANCE);
 }
 
 /**
@@ -71,7 +86,7 @@ void deltaInverseTest()
 
     double expected[SIZE];
     std::fill_n(expected, SIZE, 1.0);
-    CHECK_ARRAY_CLOSE(expected, output, SIZE, 0.0001);
+    CHECK_ARRAY_CLOSE(expected, output, SIZE, FFT_TOLERANCE);
 }
 
 /**
@@ -87,7 +102,7 @@ void constInverseTest()
 
     double expected[SIZE] = {0};
     expected[0] = 1.0;
-    CHECK_ARRAY_CLOSE(expected, output, SIZE, 0.0001);
+    CHECK_ARRAY_CLOSE(expected, output, SIZE, FFT_TOLERANCE);
 }
 
 /**
@@ -105,7 +120,162 @@ void identityTest()
     Aquila::SampleType output[SIZE];
     fft.ifft(spectrum, output);
 
-    CHECK_ARRAY_CLOSE(testArray, output, SIZE, 0.0001);
+    CHECK_ARRAY_CLOSE(testArray, output, SIZE, FFT_TOLERANCE);
+}
+
+/**
+ * Test that spectrum of an arbitrary signal matches plain DFT.
+ */
+template <typename FftType, std::size_t SIZE>
+void referenceSpectrumTest()
+{
+    Aquila::SampleType testArray[SIZE];
+    for (std::size_t i = 0; i < SIZE; ++i)
+    {
+        testArray[i] = static_cast<double>((i * 5) % 11) - 5.0 + 0.01 * i;
+    }
+
+    FftType fft(SIZE);
+    Aquila::SpectrumType spectrum = fft.fft(testArray);
+    Aquila::Dft dft(SIZE);
+    Aquila::SpectrumType expected = dft.fft(testArray);
+
+    for (std::size_t i = 0; i < SIZE; ++i)
+    {
+        CHECK_CLOSE(expected[i].real(), spectrum[i].real(), FFT_TOLERANCE);
+        CHECK_CLOSE(expected[i].imag(), spectrum[i].imag(), FFT_TOLERANCE);
+    }
+}
+
+/**
+ * Test that real FFT returns the first half of the full spectrum.
+ */
+template <typename FftType, std::size_t SIZE>
+void realSpectrumTest()
+{
+    Aquila::SampleType testArray[SIZE];
+    for (std::size_t i = 0; i < SIZE; ++i)
+    {
+        testArray[i] = static_cast<double>((i * 7) % 5) - 2.0 + 0.1 * i;
+    }
+
+    FftType fft(SIZE);
+    Aquila::SpectrumType spectrum = fft.fft(testArray);
+    Aquila::SpectrumType halfSpectrum = fft.rfft(testArray);
+    CHECK_EQUAL(SIZE / 2 + 1, halfSpectrum.size());
+
+    for (std::size_t i = 0; i < SIZE / 2 + 1; ++i)
+    {
+        CHECK_CLOSE(spectrum[i].real(), halfSpectrum[i].real(), FFT_TOLERANCE);
+        CHECK_CLOSE(spectrum[i].imag(), halfSpectrum[i].imag(), FFT_TOLERANCE);
+    }
+}
+
+/**
+ * Test that IRFFT(RFFT(x)) == x.
+ */
+template <typename FftType, std::size_t SIZE>
+void realIdentityTest()
+{
+    Aquila::SampleType testArray[SIZE];
+    for (std::size_t i = 0; i < SIZE; ++i)
+    {
+        testArray[i] = static_cast<double>((i * 3) % 7) - 3.0;
+    }
+
+    FftType fft(SIZE);
+    Aquila::SpectrumType spectrum = fft.rfft(testArray);
+
+    Aquila::SampleType output[SIZE];
+    fft.irfft(spectrum, output);
+
+    CHECK_ARRAY_CLOSE(testArray, output, SIZE, FFT_TOLERANCE);
+}
+
+/**
+ * Test that transforms into caller's buffers do not allocate memory.
+ */
+template <typename FftType, std::size_t SIZE>
+void noAllocationTest()
+{
+    Aquila::SampleType testArray[SIZE];
+    std::fill_n(testArray, SIZE, 1.0);
+    Aquila::ComplexType spectrum[SIZE];
+    Aquila::SampleType output[SIZE];
+
+    FftType fft(SIZE);
+    // first run may still prepare some lazily computed tables
+    fft.fft(testArray, spectrum);
+    fft.rfft(testArray, spectrum);
+
+    std::size_t allocations = allocationCount();
+    fft.fft(testArray, spectrum);
+    fft.ifft(spectrum, output);
+    fft.rfft(testArray, spectrum);
+    fft.irfft(spectrum, output);
+    CHECK_EQUAL(0u, allocationCount() - allocations);
+    CHECK_ARRAY_CLOSE(testArray, output, SIZE, FFT_TOLERANCE);
+}
+
+/**
+ * Test that a single-sample transform is an identity.
+ *
+ * Buffers are allocated with the exact size, so that any write past
+ * the single value is caught by memory checkers.
+ */
+template <typename FftType>
+void lengthOneTest()
+{
+    std::vector<Aquila::SampleType> x(1, 3.0), output(1, 0.0);
+    std::vector<Aquila::ComplexType> spectrum(1);
+
+    FftType fft(1);
+    fft.fft(&x[0], &spectrum[0]);
+    CHECK_CLOSE(3.0, spectrum[0].real(), FFT_TOLERANCE);
+    CHECK_CLOSE(0.0, spectrum[0].imag(), FFT_TOLERANCE);
+    fft.ifft(&spectrum[0], &output[0]);
+    CHECK_CLOSE(3.0, output[0], FFT_TOLERANCE);
+
+    spectrum[0] = 0.0;
+    output[0] = 0.0;
+    fft.rfft(&x[0], &spectrum[0]);
+    CHECK_CLOSE(3.0, spectrum[0].real(), FFT_TOLERANCE);
+    CHECK_CLOSE(0.0, spectrum[0].imag(), FFT_TOLERANCE);
+    fft.irfft(&spectrum[0], &output[0]);
+    CHECK_CLOSE(3.0, output[0], FFT_TOLERANCE);
+}
+
+/**
+ * Test that batch transforms of overlapping frames match single ones.
+ */
+template <typename FftType, std::size_t SIZE, std::size_t COUNT>
+void batchTest()
+{
+    const std::size_t stride = SIZE / 2;
+    std::vector<Aquila::SampleType> signal((COUNT - 1) * stride + SIZE);
+    for (std::size_t i = 0; i < signal.size(); ++i)
+    {
+        signal[i] = static_cast<double>((i * 13) % 11) - 5.0;
+    }
+
+    FftType fft(SIZE);
+    std::vector<Aquila::ComplexType> spectra(COUNT * SIZE);
+    fft.fftBatch(&signal[0], stride, COUNT, &spectra[0]);
+    std::vector<Aquila::ComplexType> halfSpectra(COUNT * (SIZE / 2 + 1));
+    fft.rfftBatch(&signal[0], stride, COUNT, &halfSpectra[0]);
+
+    for (std::size_t i = 0; i < COUNT; ++i)
+    {
+        Aquila::SpectrumType expected = fft.fft(&signal[i * stride]);
+        for (std::size_t k = 0; k < SIZE; ++k)
+        {
+            CHECK_CLOSE(0.0, std::abs(expected[k] - spectra[i * SIZE + k]), FFT_TOLERANCE);
+        }
+        for (std::size_t k = 0; k < SIZE / 2 + 1; ++k)
+        {
+            CHECK_CLOSE(0.0, std::abs(expected[k] - halfSpectra[i * (SIZE / 2 + 1) + k]), FFT_TOLERANCE);
+        }
+    }
 }
 
 #endif // AQUILA_TEST_FFT_H
@@ -0,0 +1,180 @@
+#include "aquila/global.h"
+#include "aquila/Exceptions.h"
+#include "aquila/transform/FftFactory.h"
+#include "constants.h"
+#include "UnitTest++/UnitTest++.h"
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+
+namespace
+{
+    /**
+     * Writes a wisdom file measured with the given kernel.
+     */
+    void writeWisdom(const std::string& kernel, const char* entries)
+    {
+        std::ofstream fs(Aquila_TEST_WISDOMFILE_OUTPUT);
+        if (!kernel.empty())
+        {
+            fs << "kernel " << kernel << "\n";
+        }
+        fs << entries;
+    }
+}
+
+
+SUITE(FftFactory)
+{
+    TEST(DefaultPlanningMode)
+    {
+        CHECK_EQUAL(Aquila::FftFactory::Estimate,
+                    Aquila::FftFactory::getPlanningMode());
+    }
+
+    TEST(EstimatedBackends)
+    {
+        Aquila::FftFactory::clearWisdom();
+        CHECK_EQUAL(Aquila::FftFactory::OouraBackend,
+                    Aquila::FftFactory::getDefaultBackend(512));
+        CHECK_EQUAL(Aquila::FftFactory::MixedRadixBackend,
+                    Aquila::FftFactory::getDefaultBackend(400));
+        CHECK_EQUAL(Aquila::FftFactory::BluesteinBackend,
+                    Aquila::FftFactory::getDefaultBackend(401));
+    }
+
+    TEST(MeasurePowerOf2)
+    {
+        Aquila::FftFactory::clearWisdom();
+        auto backend = Aquila::FftFactory::measure(256);
+        CHECK(backend != Aquila::FftFactory::DefaultBackend);
+        CHECK(backend != Aquila::FftFactory::BluesteinBackend);
+        CHECK_EQUAL(backend, Aquila::FftFactory::getDefaultBackend(256));
+        Aquila::FftFactory::clearWisdom();
+    }
+
+    TEST(MeasureOtherLength)
+    {
+        Aquila::FftFactory::clearWisdom();
+        auto backend = Aquila::FftFactory::measure(401);
+        CHECK_EQUAL(Aquila::FftFactory::BluesteinBackend, backend);
+        backend = Aquila::FftFactory::measure(400);
+        CHECK(backend == Aquila::FftFactory::MixedRadixBackend ||
+              backend == Aquila::FftFactory::BluesteinBackend);
+        Aquila::FftFactory::clearWisdom();
+    }
+
+    TEST(MeasuringMode)
+    {
+        Aquila::FftFactory::clearWisdom();
+        Aquila::FftFactory::setPlanningMode(Aquila::FftFactory::Measure);
+        auto fft = Aquila::FftFactory::getFft(128);
+        Aquila::FftFactory::setPlanningMode(Aquila::FftFactory::Estimate);
+        CHECK_EQUAL(128u, fft->getLength());
+        // the measured backend is remembered
+        auto backend = Aquila::FftFactory::getDefaultBackend(128);
+        CHECK(fft == Aquila::FftFactory::getFft(128, backend));
+        Aquila::FftFactory::clearWisdom();
+    }
+
+    TEST(LoadWisdom)
+    {
+        Aquila::FftFactory::clearWisdom();
+        writeWisdom(Aquila::FftFactory::getKernelName(),
+                    "64 radix4\n400 bluestein\n1024 aquila\n");
+        Aquila::FftFactory::loadWisdom(Aquila_TEST_WISDOMFILE_OUTPUT);
+        CHECK_EQUAL(Aquila::FftFactory::Radix4Backend,
+                    Aquila::FftFactory::getDefaultBackend(64));
+        CHECK_EQUAL(Aquila::FftFactory::BluesteinBackend,
+                    Aquila::FftFactory::getDefaultBackend(400));
+        CHECK_EQUAL(Aquila::FftFactory::AquilaBackend,
+                    Aquila::FftFactory::getDefaultBackend(1024));
+        // lengths without wisdom are still estimated
+        CHECK_EQUAL(Aquila::FftFactory::OouraBackend,
+                    Aquila::FftFactory::getDefaultBackend(512));
+        Aquila::FftFactory::clearWisdom();
+    }
+
+    TEST(SaveWisdom)
+    {
+        Aquila::FftFactory::clearWisdom();
+        writeWisdom(Aquila::FftFactory::getKernelName(),
+                    "64 radix4\n400 bluestein\n");
+        Aquila::FftFactory::loadWisdom(Aquila_TEST_WISDOMFILE_OUTPUT);
+        Aquila::FftFactory::saveWisdom(Aquila_TEST_WISDOMFILE_OUTPUT);
+        Aquila::FftFactory::clearWisdom();
+        Aquila::FftFactory::loadWisdom(Aquila_TEST_WISDOMFILE_OUTPUT);
+        CHECK_EQUAL(Aquila::FftFactory::Radix4Backend,
+                    Aquila::FftFactory::getDefaultBackend(64));
+        CHECK_EQUAL(Aquila::FftFactory::BluesteinBackend,
+                    Aquila::FftFactory::getDefaultBackend(400));
+        Aquila::FftFactory::clearWisdom();
+    }
+
+    TEST(UnsupportedWisdomIgnored)
+    {
+        Aquila::FftFactory::clearWisdom();
+        writeWisdom(Aquila::FftFactory::getKernelName(),
+                    "400 ooura\n400 radix4\n401 mixedradix\n");
+        Aquila::FftFactory::loadWisdom(Aquila_TEST_WISDOMFILE_OUTPUT);
+        CHECK_EQUAL(Aquila::FftFactory::MixedRadixBackend,
+                    Aquila::FftFactory::getDefaultBackend(400));
+        CHECK_EQUAL(Aquila::FftFactory::BluesteinBackend,
+                    Aquila::FftFactory::getDefaultBackend(401));
+        Aquila::FftFactory::clearWisdom();
+    }
+
+    TEST(ForeignWisdomIgnored)
+    {
+        Aquila::FftFactory::clearWisdom();
+        Aquila::FftFactory::loadWisdom(Aquila_TEST_WISDOMFILE);
+        CHECK_EQUAL(Aquila::FftFactory::OouraBackend,
+                    Aquila::FftFactory::getDefaultBackend(64));
+        CHECK_EQUAL(Aquila::FftFactory::MixedRadixBackend,
+                    Aquila::FftFactory::getDefaultBackend(400));
+
+        // files without a kernel line are not trusted either
+        writeWisdom("", "64 radix4\n");
+        Aquila::FftFactory::loadWisdom(Aquila_TEST_WISDOMFILE_OUTPUT);
+        CHECK_EQUAL(Aquila::FftFactory::OouraBackend,
+                    Aquila::FftFactory::getDefaultBackend(64));
+        Aquila::FftFactory::clearWisdom();
+    }
+
+    TEST(MissingWisdomFile)
+    {
+        CHECK_THROW(Aquila::FftFactory::loadWisdom("nonexistent_wisdom.txt"),
+                    Aquila::Exception);
+    }
+
+    TEST(InvalidWisdomFile)
+    {
+        CHECK_THROW(Aquila::FftFactory::loadWisdom(
+                        Aquila_TEST_WISDOMFILE_INVALID),
+                    Aquila::FormatException);
+    }
+
+    TEST(UnsupportedLengthThrows)
+    {
+        CHECK_THROW(Aquila::FftFactory::getFft(400, Aquila::FftFactory::OouraBackend),
+                    Aquila::Exception);
+        CHECK_THROW(Aquila::FftFactory::getFft(400, Aquila::FftFactory::Radix4Backend),
+                    Aquila::Exception);
+        CHECK_THROW(Aquila::FftFactory::getFft(400, Aquila::FftFactory::AquilaBackend),
+                    Aquila::Exception);
+        CHECK_THROW(Aquila::FftFactory::getFft(401, Aquila::FftFactory::MixedRadixBackend),
+                    Aquila::Exception);
+        CHECK(Aquila::FftFactory::getFft(401, Aquila::FftFactory::BluesteinBackend));
+    }
+
+    TEST(ZeroLengthThrows)
+    {
+        Aquila::FftFactory::clearWisdom();
+        CHECK_THROW(Aquila::FftFactory::getDefaultBackend(0), Aquila::Exception);
+        CHECK_THROW(Aquila::FftFactory::getFft(0), Aquila::Exception);
+        CHECK_THROW(Aquila::FftFactory::getFft(0, Aquila::FftFactory::BluesteinBackend),
+                    Aquila::Exception);
+        CHECK(!Aquila::FftFactory::isSupportedLength(0, Aquila::FftFactory::DefaultBackend));
+    }
+}
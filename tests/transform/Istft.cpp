@@ -0,0 +1,110 @@
+#include "aquila/global.h"
+#include "aquila/Exceptions.h"
+#include "aquila/source/generator/SineGenerator.h"
+#include "aquila/transform/Istft.h"
+#include "aquila/transform/Stft.h"
+#include "Fft.h"
+#include "UnitTest++/UnitTest++.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+
+SUITE(Istft)
+{
+    const std::size_t SIZE = 1088;
+    Aquila::FrequencyType sampleFrequency = 1024;
+
+    TEST(InvalidHopThrows)
+    {
+        const std::size_t hop = 300;
+        CHECK_THROW(Aquila::Istft istft(256, hop), Aquila::Exception);
+    }
+
+    TEST(PerfectReconstruction)
+    {
+        const std::size_t FRAME = 256, HOP = 64;
+        Aquila::SineGenerator generator(sampleFrequency);
+        generator.setFrequency(50).setAmplitude(1).generate(SIZE);
+
+        Aquila::Stft stft(FRAME, HOP, Aquila::Stft::Hamming);
+        Aquila::Istft istft(FRAME, HOP, Aquila::Stft::Hamming);
+        auto output = istft.inverse(stft.transform(generator));
+
+        CHECK_EQUAL(SIZE, output.size());
+        CHECK_ARRAY_CLOSE(generator.toArray(), output, SIZE, FFT_TOLERANCE);
+    }
+
+    TEST(HannEdgeSamples)
+    {
+        const std::size_t FRAME = 128, HOP = 32;
+        Aquila::SineGenerator generator(sampleFrequency);
+        generator.setFrequency(80).setAmplitude(1).generate(SIZE);
+
+        Aquila::Stft stft(FRAME, HOP, Aquila::Stft::Hann);
+        Aquila::Istft istft(FRAME, HOP, Aquila::Stft::Hann);
+        auto output = istft.inverse(stft.transform(generator));
+
+        // Hann window is zero at both ends, so the first and last sample
+        // are not covered by any frame
+        CHECK_EQUAL(0.0, output[0]);
+        CHECK_EQUAL(0.0, output[SIZE - 1]);
+        CHECK_ARRAY_CLOSE(generator.toArray() + 1, output.data() + 1,
+                          SIZE - 2, FFT_TOLERANCE);
+    }
+
+    TEST(StreamingSameAsWhole)
+    {
+        const std::size_t FRAME = 128, HOP = 48;
+        Aquila::SineGenerator generator(sampleFrequency);
+        generator.setFrequency(120).setAmplitude(1).generate(SIZE);
+
+        Aquila::Stft stft(FRAME, HOP, Aquila::Stft::Blackman);
+        auto spectra = stft.transform(generator);
+        const std::size_t frameCount = stft.getFrameCount(SIZE);
+
+        Aquila::Istft istft(FRAME, HOP, Aquila::Stft::Blackman);
+        auto expected = istft.inverse(spectra);
+
+        // blocks of 1, 2, 3... frames
+        std::vector<Aquila::SampleType> output(istft.getSignalLength(frameCount));
+        std::size_t frame = 0, written = 0;
+        for (std::size_t block = 1; frame < frameCount; ++block)
+        {
+            const std::size_t count = std::min(block, frameCount - frame);
+            written += istft.process(&spectra[frame * stft.getBinCount()],
+                                     count, &output[written]);
+            frame += count;
+        }
+        written += istft.flush(&output[written]);
+
+        CHECK_EQUAL(expected.size(), written);
+        CHECK_ARRAY_EQUAL(expected, output, expected.size());
+    }
+
+    TEST(SpectralMasking)
+    {
+        const std::size_t FRAME = 256, HOP = 64;
+        Aquila::SineGenerator low(sampleFrequency), high(sampleFrequency);
+        low.setFrequency(32).setAmplitude(1).generate(SIZE);
+        high.setFrequency(256).setAmplitude(1).generate(SIZE);
+        auto sum = low + high;
+
+        Aquila::Stft stft(FRAME, HOP, Aquila::Stft::Hamming);
+        auto spectra = stft.transform(sum);
+        const std::size_t binCount = stft.getBinCount();
+        for (std::size_t i = 0; i < spectra.size(); ++i)
+        {
+            // remove everything above 128 Hz
+            if (i % binCount > 32)
+            {
+                spectra[i] = 0.0;
+            }
+        }
+
+        Aquila::Istft istft(FRAME, HOP, Aquila::Stft::Hamming);
+        auto output = istft.inverse(spectra);
+        CHECK_ARRAY_CLOSE(low.toArray(), output, SIZE, 0.01);
+    }
+}
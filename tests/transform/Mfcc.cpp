@@ -1,23 +1,189 @@
 #include "aquila/global.h"
+#include "aquila/filter/MelFilter.h"
+#include "aquila/filter/MelFilterBank.h"
+#include "aquila/source/FrameView.h"
+#include "aquila/source/FramesCollection.h"
+#include "aquila/source/SignalSource.h"
 #include "aquila/source/generator/SineGenerator.h"
+#include "aquila/transform/Dft.h"
 #include "aquila/transform/Mfcc.h"
 #include "UnitTest++/UnitTest++.h"
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <vector>
 
 
 SUITE(Mfcc)
 {
     TEST(Sine9Coeffs)
     {
-        const std::size_t NUM_FEATURES = 9;
-        Aquila::SineGenerator generator(2048);
-        generator.setAmplitude(1).setFrequency(128).generate(2048);
+        const std::size_t NUM_FEATURES = 9, NUM_FILTERS = 26, SIZE = 2048;
+        const Aquila::FrequencyType sampleFrequency = 2048;
+        Aquila::SineGenerator generator(sampleFrequency);
+        generator.setAmplitude(1).setFrequency(128).generate(SIZE);
 
         Aquila::Mfcc mfcc(generator.getSamplesCount());
         auto mfccValues = mfcc.calculate(generator, NUM_FEATURES);
-        Aquila::SampleType expected[NUM_FEATURES] = {
-            418.046, 200.327, 35.796, 485.892, 311.312, -111.424, 214.684, 311.887, -194.111
-        };
-        CHECK_ARRAY_CLOSE(expected, mfccValues, NUM_FEATURES, 0.001);
+        auto energies = mfcc.calculate(generator, Aquila::Mfcc::MelEnergies);
+        auto logEnergies = mfcc.calculate(generator, Aquila::Mfcc::LogMelEnergies);
+        CHECK_EQUAL(NUM_FEATURES, mfccValues.size());
+
+        // the tone falls exactly on a bin, so all filters but two see only
+        // rounding noise of the transform; its logarithm depends on the
+        // FFT backend, so the reference is compared before taking logs
+        Aquila::Dft dft(SIZE);
+        auto spectrum = dft.rfft(generator.toArray());
+        std::vector<double> pspec(SIZE / 2);
+        for (std::size_t k = 0; k < SIZE / 2; ++k)
+        {
+            pspec[k] = std::norm(spectrum[k]) / SIZE;
+        }
+        auto melHigh = Aquila::MelFilter::linearToMel(sampleFrequency / 2);
+        Aquila::MelFilterBank bank(sampleFrequency, SIZE,
+                                   2 * melHigh / (NUM_FILTERS + 1), NUM_FILTERS);
+        auto expectedEnergies = bank.applyAll(pspec);
+        CHECK_ARRAY_CLOSE(expectedEnergies, energies, NUM_FILTERS, 0.001);
+
+        // 0th coefficient is the log of total power: 1/4 of SIZE for a sine
+        CHECK_CLOSE(std::log(SIZE / 4.0), mfccValues[0], 0.0001);
+
+        // the rest is DCT-II of log energies, liftered with L = 22
+        const double L = 22;
+        for (std::size_t n = 1; n < NUM_FEATURES; ++n)
+        {
+            double sum = 0.0;
+            for (std::size_t k = 0; k < NUM_FILTERS; ++k)
+            {
+                sum += logEnergies[k] *
+                    std::cos(M_PI * n * (2 * k + 1) / (2.0 * NUM_FILTERS));
+            }
+            double expected = sum * std::sqrt(2.0 / NUM_FILTERS) *
+                (1 + L / 2 * std::sin(M_PI * n / L));
+            CHECK_CLOSE(expected, mfccValues[n], 0.001);
+        }
+    }
+
+    TEST(CalculateAllSameAsCalculate)
+    {
+        const std::size_t NUM_FEATURES = 12, FRAME_SIZE = 256;
+        Aquila::SineGenerator generator(8000);
+        generator.setAmplitude(1000).setFrequency(440).generate(4000);
+        Aquila::FramesCollection frames(generator, FRAME_SIZE, FRAME_SIZE / 2);
+
+        Aquila::Mfcc mfcc(FRAME_SIZE);
+        auto allValues = mfcc.calculateAll(frames, NUM_FEATURES);
+
+        CHECK_EQUAL(frames.count() * NUM_FEATURES, allValues.size());
+        for (std::size_t i = 0; i < frames.count(); ++i)
+        {
+            auto mfccValues = mfcc.calculate(frames.frame(i), NUM_FEATURES);
+            CHECK_ARRAY_CLOSE(mfccValues, &allValues[i * NUM_FEATURES],
+                              NUM_FEATURES, 0.000001);
+        }
+    }
+
+    TEST(CalculateAllFrameViews)
+    {
+        const std::size_t FRAME_SIZE = 256;
+        Aquila::SineGenerator generator(8000);
+        generator.setAmplitude(1000).setFrequency(440).generate(4000);
+        Aquila::FramesCollection frames(generator, FRAME_SIZE, FRAME_SIZE / 2);
+        Aquila::FrameViews views(generator, FRAME_SIZE, FRAME_SIZE / 2);
+
+        Aquila::Mfcc mfcc(FRAME_SIZE);
+        auto expected = mfcc.calculateAll(frames);
+        auto allValues = mfcc.calculateAll(views, 8000);
+        CHECK_EQUAL(expected.size(), allValues.size());
+        CHECK_ARRAY_CLOSE(expected, allValues, expected.size(), 0.000001);
+
+        auto logMel = mfcc.calculateAll(views, 8000, Aquila::Mfcc::LogMelEnergies);
+        CHECK_EQUAL(views.size() * 26, logMel.size());
+    }
+
+    TEST(CalculateAllEmptyCollection)
+    {
+        Aquila::FramesCollection frames;
+        Aquila::Mfcc mfcc(256);
+        auto allValues = mfcc.calculateAll(frames);
+
+        CHECK_EQUAL(0u, allValues.size());
+    }
+
+    TEST(ShortInputZeroPadded)
+    {
+        const std::size_t NUM_FEATURES = 13, INPUT_SIZE = 400;
+        Aquila::SineGenerator generator(16000);
+        generator.setAmplitude(1000).setFrequency(1000).generate(300);
+
+        std::vector<Aquila::SampleType> padded(generator.begin(), generator.end());
+        padded.resize(INPUT_SIZE, 0);
+        Aquila::SignalSource paddedSource(padded, 16000);
+
+        Aquila::Mfcc mfcc(INPUT_SIZE);
+        auto mfccValues = mfcc.calculate(generator, NUM_FEATURES);
+        auto expected = mfcc.calculate(paddedSource, NUM_FEATURES);
+
+        CHECK_EQUAL(NUM_FEATURES, mfccValues.size());
+        CHECK_ARRAY_CLOSE(expected, mfccValues, NUM_FEATURES, 0.000001);
+    }
+
+    TEST(StageSizes)
+    {
+        Aquila::Mfcc mfcc(400, 40);
+
+        CHECK_EQUAL(200u, mfcc.getStageSize(Aquila::Mfcc::PowerSpectrum));
+        CHECK_EQUAL(40u, mfcc.getStageSize(Aquila::Mfcc::MelEnergies));
+        CHECK_EQUAL(40u, mfcc.getStageSize(Aquila::Mfcc::LogMelEnergies));
+        CHECK_EQUAL(13u, mfcc.getStageSize(Aquila::Mfcc::Cepstra, 13));
+    }
+
+    TEST(StageOutputs)
+    {
+        const std::size_t FRAME_SIZE = 256, NUM_FILTERS = 20;
+        const Aquila::FrequencyType sampleFrequency = 8000;
+        Aquila::SineGenerator generator(sampleFrequency);
+        generator.setAmplitude(1000).setFrequency(700).generate(1024);
+        Aquila::FramesCollection frames(generator, FRAME_SIZE);
+
+        Aquila::Mfcc mfcc(FRAME_SIZE, NUM_FILTERS);
+        auto pspec = mfcc.calculateAll(frames, Aquila::Mfcc::PowerSpectrum);
+        auto energies = mfcc.calculateAll(frames, Aquila::Mfcc::MelEnergies);
+        auto logEnergies = mfcc.calculateAll(frames, Aquila::Mfcc::LogMelEnergies);
+        auto cepstra = mfcc.calculateAll(frames, Aquila::Mfcc::Cepstra, 12);
+
+        CHECK_EQUAL(frames.count() * FRAME_SIZE / 2, pspec.size());
+        CHECK_EQUAL(frames.count() * NUM_FILTERS, energies.size());
+        CHECK_EQUAL(frames.count() * NUM_FILTERS, logEnergies.size());
+        CHECK_ARRAY_CLOSE(mfcc.calculateAll(frames, 12), cepstra,
+                          cepstra.size(), 0.000001);
+
+        // the tone is the strongest bin of power spectrum
+        auto peak = std::max_element(pspec.begin(), pspec.begin() + FRAME_SIZE / 2);
+        CHECK_EQUAL(700u * FRAME_SIZE / 8000, std::size_t(peak - pspec.begin()));
+
+        auto melHigh = Aquila::MelFilter::linearToMel(sampleFrequency / 2);
+        Aquila::MelFilterBank bank(sampleFrequency, FRAME_SIZE,
+                                   2 * melHigh / (NUM_FILTERS + 1), NUM_FILTERS);
+        for (std::size_t i = 0; i < frames.count(); ++i)
+        {
+            std::vector<double> framePSpec(pspec.begin() + i * FRAME_SIZE / 2,
+                                           pspec.begin() + (i + 1) * FRAME_SIZE / 2);
+            auto expected = bank.applyAll(framePSpec);
+            CHECK_ARRAY_CLOSE(expected, &energies[i * NUM_FILTERS],
+                              NUM_FILTERS, 0.000001);
+            for (std::size_t j = 0; j < NUM_FILTERS; ++j)
+            {
+                double value = energies[i * NUM_FILTERS + j];
+                if (value > 0)
+                {
+                    CHECK_CLOSE(std::log(value), logEnergies[i * NUM_FILTERS + j],
+                                0.000001);
+                }
+            }
+        }
+
+        auto single = mfcc.calculate(frames.frame(1), Aquila::Mfcc::LogMelEnergies);
+        CHECK_ARRAY_CLOSE(&logEnergies[NUM_FILTERS], single, NUM_FILTERS, 0.000001);
     }
 }
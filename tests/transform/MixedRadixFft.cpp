@@ -0,0 +1,107 @@
+#include "Fft.h"
+#include "aquila/global.h"
+#include "aquila/transform/MixedRadixFft.h"
+#include "UnitTest++/UnitTest++.h"
+
+
+SUITE(MixedRadixFft)
+{
+    TEST(Delta)
+    {
+        deltaSpectrumTest<Aquila::MixedRadixFft, 6>();
+        deltaSpectrumTest<Aquila::MixedRadixFft, 12>();
+        deltaSpectrumTest<Aquila::MixedRadixFft, 400>();
+        deltaSpectrumTest<Aquila::MixedRadixFft, 1024>();
+    }
+
+    TEST(ConstSignal)
+    {
+        constSpectrumTest<Aquila::MixedRadixFft, 6>();
+        constSpectrumTest<Aquila::MixedRadixFft, 12>();
+        constSpectrumTest<Aquila::MixedRadixFft, 400>();
+        constSpectrumTest<Aquila::MixedRadixFft, 1024>();
+    }
+
+    TEST(ReferenceSpectrum)
+    {
+        referenceSpectrumTest<Aquila::MixedRadixFft, 1>();
+        referenceSpectrumTest<Aquila::MixedRadixFft, 2>();
+        referenceSpectrumTest<Aquila::MixedRadixFft, 3>();
+        referenceSpectrumTest<Aquila::MixedRadixFft, 5>();
+        referenceSpectrumTest<Aquila::MixedRadixFft, 7>();
+        referenceSpectrumTest<Aquila::MixedRadixFft, 10>();
+        referenceSpectrumTest<Aquila::MixedRadixFft, 12>();
+        referenceSpectrumTest<Aquila::MixedRadixFft, 30>();
+        referenceSpectrumTest<Aquila::MixedRadixFft, 49>();
+        referenceSpectrumTest<Aquila::MixedRadixFft, 105>();
+        referenceSpectrumTest<Aquila::MixedRadixFft, 400>();
+        referenceSpectrumTest<Aquila::MixedRadixFft, 480>();
+        referenceSpectrumTest<Aquila::MixedRadixFft, 1024>();
+    }
+
+    TEST(DeltaInverse)
+    {
+        deltaInverseTest<Aquila::MixedRadixFft, 6>();
+        deltaInverseTest<Aquila::MixedRadixFft, 12>();
+        deltaInverseTest<Aquila::MixedRadixFft, 400>();
+        deltaInverseTest<Aquila::MixedRadixFft, 1024>();
+    }
+
+    TEST(ConstInverse)
+    {
+        constInverseTest<Aquila::MixedRadixFft, 6>();
+        constInverseTest<Aquila::MixedRadixFft, 12>();
+        constInverseTest<Aquila::MixedRadixFft, 400>();
+        constInverseTest<Aquila::MixedRadixFft, 1024>();
+    }
+
+    TEST(Identity)
+    {
+        identityTest<Aquila::MixedRadixFft, 6>();
+        identityTest<Aquila::MixedRadixFft, 12>();
+        identityTest<Aquila::MixedRadixFft, 400>();
+        identityTest<Aquila::MixedRadixFft, 1024>();
+    }
+
+    TEST(RealSpectrum)
+    {
+        realSpectrumTest<Aquila::MixedRadixFft, 6>();
+        realSpectrumTest<Aquila::MixedRadixFft, 12>();
+        realSpectrumTest<Aquila::MixedRadixFft, 400>();
+        realSpectrumTest<Aquila::MixedRadixFft, 1024>();
+    }
+
+    TEST(RealIdentity)
+    {
+        realIdentityTest<Aquila::MixedRadixFft, 1>();
+        realIdentityTest<Aquila::MixedRadixFft, 2>();
+        realIdentityTest<Aquila::MixedRadixFft, 3>();
+        realIdentityTest<Aquila::MixedRadixFft, 5>();
+        realIdentityTest<Aquila::MixedRadixFft, 7>();
+        realIdentityTest<Aquila::MixedRadixFft, 10>();
+        realIdentityTest<Aquila::MixedRadixFft, 12>();
+        realIdentityTest<Aquila::MixedRadixFft, 30>();
+        realIdentityTest<Aquila::MixedRadixFft, 49>();
+        realIdentityTest<Aquila::MixedRadixFft, 105>();
+        realIdentityTest<Aquila::MixedRadixFft, 400>();
+        realIdentityTest<Aquila::MixedRadixFft, 480>();
+        realIdentityTest<Aquila::MixedRadixFft, 1024>();
+    }
+
+    TEST(NoAllocations)
+    {
+        noAllocationTest<Aquila::MixedRadixFft, 400>();
+        noAllocationTest<Aquila::MixedRadixFft, 1024>();
+    }
+
+    TEST(LengthOne)
+    {
+        lengthOneTest<Aquila::MixedRadixFft>();
+    }
+
+    TEST(Batch)
+    {
+        batchTest<Aquila::MixedRadixFft, 12, 3>();
+        batchTest<Aquila::MixedRadixFft, 400, 40>();
+    }
+}
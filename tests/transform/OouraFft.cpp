@@ -45,4 +45,38 @@ SUITE(OouraFft)
         identityTest<Aquila::OouraFft, 128>();
         identityTest<Aquila::OouraFft, 1024>();
     }
+
+    TEST(RealSpectrum)
+    {
+        realSpectrumTest<Aquila::OouraFft, 8>();
+        realSpectrumTest<Aquila::OouraFft, 16>();
+        realSpectrumTest<Aquila::OouraFft, 128>();
+        realSpectrumTest<Aquila::OouraFft, 1024>();
+    }
+
+    TEST(RealIdentity)
+    {
+        realIdentityTest<Aquila::OouraFft, 8>();
+        realIdentityTest<Aquila::OouraFft, 16>();
+        realIdentityTest<Aquila::OouraFft, 128>();
+        realIdentityTest<Aquila::OouraFft, 1024>();
+    }
+
+    TEST(NoAllocations)
+    {
+        noAllocationTest<Aquila::OouraFft, 8>();
+        noAllocationTest<Aquila::OouraFft, 128>();
+        noAllocationTest<Aquila::OouraFft, 1024>();
+    }
+
+    TEST(LengthOne)
+    {
+        lengthOneTest<Aquila::OouraFft>();
+    }
+
+    TEST(Batch)
+    {
+        batchTest<Aquila::OouraFft, 8, 3>();
+        batchTest<Aquila::OouraFft, 1024, 80>();
+    }
 }
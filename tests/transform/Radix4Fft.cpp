@@ -0,0 +1,110 @@
+#include "Fft.h"
+#include "aquila/global.h"
+#include "aquila/transform/Radix4Fft.h"
+#include "UnitTest++/UnitTest++.h"
+#include <string>
+
+
+SUITE(Radix4Fft)
+{
+    TEST(Delta)
+    {
+        deltaSpectrumTest<Aquila::Radix4Fft, 8>();
+        deltaSpectrumTest<Aquila::Radix4Fft, 16>();
+        deltaSpectrumTest<Aquila::Radix4Fft, 32>();
+        deltaSpectrumTest<Aquila::Radix4Fft, 128>();
+        deltaSpectrumTest<Aquila::Radix4Fft, 1024>();
+    }
+
+    TEST(ConstSignal)
+    {
+        constSpectrumTest<Aquila::Radix4Fft, 8>();
+        constSpectrumTest<Aquila::Radix4Fft, 16>();
+        constSpectrumTest<Aquila::Radix4Fft, 128>();
+        constSpectrumTest<Aquila::Radix4Fft, 1024>();
+    }
+
+    TEST(ReferenceSpectrum)
+    {
+        referenceSpectrumTest<Aquila::Radix4Fft, 1>();
+        referenceSpectrumTest<Aquila::Radix4Fft, 2>();
+        referenceSpectrumTest<Aquila::Radix4Fft, 4>();
+        referenceSpectrumTest<Aquila::Radix4Fft, 8>();
+        referenceSpectrumTest<Aquila::Radix4Fft, 16>();
+        referenceSpectrumTest<Aquila::Radix4Fft, 32>();
+        referenceSpectrumTest<Aquila::Radix4Fft, 64>();
+        referenceSpectrumTest<Aquila::Radix4Fft, 512>();
+        referenceSpectrumTest<Aquila::Radix4Fft, 1024>();
+    }
+
+    TEST(KernelName)
+    {
+        Aquila::Radix4Fft fft(64);
+        std::string name = fft.getKernelName();
+        CHECK(name == "avx2" || name == "sse2" || name == "neon" ||
+              name == "scalar");
+    }
+
+    TEST(DeltaInverse)
+    {
+        deltaInverseTest<Aquila::Radix4Fft, 8>();
+        deltaInverseTest<Aquila::Radix4Fft, 16>();
+        deltaInverseTest<Aquila::Radix4Fft, 128>();
+        deltaInverseTest<Aquila::Radix4Fft, 1024>();
+    }
+
+    TEST(ConstInverse)
+    {
+        constInverseTest<Aquila::Radix4Fft, 8>();
+        constInverseTest<Aquila::Radix4Fft, 16>();
+        constInverseTest<Aquila::Radix4Fft, 128>();
+        constInverseTest<Aquila::Radix4Fft, 1024>();
+    }
+
+    TEST(Identity)
+    {
+        identityTest<Aquila::Radix4Fft, 8>();
+        identityTest<Aquila::Radix4Fft, 16>();
+        identityTest<Aquila::Radix4Fft, 32>();
+        identityTest<Aquila::Radix4Fft, 64>();
+        identityTest<Aquila::Radix4Fft, 128>();
+        identityTest<Aquila::Radix4Fft, 1024>();
+    }
+
+    TEST(RealSpectrum)
+    {
+        realSpectrumTest<Aquila::Radix4Fft, 8>();
+        realSpectrumTest<Aquila::Radix4Fft, 16>();
+        realSpectrumTest<Aquila::Radix4Fft, 32>();
+        realSpectrumTest<Aquila::Radix4Fft, 64>();
+        realSpectrumTest<Aquila::Radix4Fft, 128>();
+        realSpectrumTest<Aquila::Radix4Fft, 1024>();
+    }
+
+    TEST(RealIdentity)
+    {
+        realIdentityTest<Aquila::Radix4Fft, 8>();
+        realIdentityTest<Aquila::Radix4Fft, 16>();
+        realIdentityTest<Aquila::Radix4Fft, 32>();
+        realIdentityTest<Aquila::Radix4Fft, 128>();
+        realIdentityTest<Aquila::Radix4Fft, 1024>();
+    }
+
+    TEST(NoAllocations)
+    {
+        noAllocationTest<Aquila::Radix4Fft, 8>();
+        noAllocationTest<Aquila::Radix4Fft, 128>();
+        noAllocationTest<Aquila::Radix4Fft, 1024>();
+    }
+
+    TEST(LengthOne)
+    {
+        lengthOneTest<Aquila::Radix4Fft>();
+    }
+
+    TEST(Batch)
+    {
+        batchTest<Aquila::Radix4Fft, 8, 3>();
+        batchTest<Aquila::Radix4Fft, 1024, 80>();
+    }
+}
@@ -1,8 +1,13 @@
 #include "aquila/global.h"
 #include "aquila/source/generator/SineGenerator.h"
+#include "aquila/source/FrameView.h"
 #include "aquila/source/FramesCollection.h"
+#include "aquila/functions.h"
 #include "aquila/transform/Spectrogram.h"
 #include "UnitTest++/UnitTest++.h"
+#include <cmath>
+#include <cstddef>
+#include <vector>
 
 void testSpectrumPeaks(std::size_t SIZE,
                        Aquila::FrequencyType sampleFrequency,
@@ -60,4 +65,123 @@ SUITE(Spectrogram)
         testSpectrumPeaks(1024, 1024, 32);
         testSpectrumPeaks(4096, 1024, 32);
     }
+
+    TEST(HalfSpectrumStorage)
+    {
+        Aquila::SineGenerator generator(sampleFrequency);
+        generator.setFrequency(100).setAmplitude(1).generate(SIZE);
+        Aquila::FramesCollection frames(generator, SIZE / 4);
+
+        Aquila::Spectrogram spectrogram(frames);
+        const std::size_t N = SIZE / 4;
+        CHECK_EQUAL(N / 2 + 1, spectrogram.getBinCount());
+        CHECK_EQUAL(Aquila::Spectrogram::ComplexStorage,
+                    spectrogram.getStorageType());
+
+        for (std::size_t x = 0; x < spectrogram.getFrameCount(); ++x)
+        {
+            const Aquila::ComplexType* row = spectrogram.getRow(x);
+            for (std::size_t y = 1; y < N / 2; ++y)
+            {
+                auto upper = spectrogram.getPoint(x, N - y);
+                CHECK_CLOSE(row[y].real(), upper.real(), 0.000001);
+                CHECK_CLOSE(-row[y].imag(), upper.imag(), 0.000001);
+            }
+        }
+        // next frame starts right after the previous one
+        CHECK(spectrogram.getRow(1) == spectrogram.getRow(0) + N / 2 + 1);
+    }
+
+    TEST(Columns)
+    {
+        Aquila::SineGenerator generator(sampleFrequency);
+        generator.setFrequency(64).setAmplitude(1).generate(SIZE);
+        Aquila::FramesCollection frames(generator, SIZE / 4);
+
+        Aquila::Spectrogram spectrogram(frames);
+        const std::size_t bin = 64 * (SIZE / 4) / 1024;
+        auto column = spectrogram.getColumn(bin);
+
+        CHECK_EQUAL(spectrogram.getFrameCount(), column.size());
+        for (std::size_t x = 0; x < column.size(); ++x)
+        {
+            CHECK_CLOSE(SIZE / 8.0, std::abs(column[x]), 0.00001);
+            CHECK_CLOSE(std::abs(spectrogram.getPoint(x, bin)),
+                        std::abs(column[x]), 0.000001);
+        }
+    }
+
+    TEST(RealStorage)
+    {
+        Aquila::SineGenerator generator(sampleFrequency);
+        generator.setFrequency(100).setAmplitude(1).generate(SIZE);
+        Aquila::FramesCollection frames(generator, SIZE / 4);
+
+        Aquila::Spectrogram complexSpectrogram(frames);
+        Aquila::Spectrogram magnitudes(frames, Aquila::Spectrogram::MagnitudeStorage);
+        Aquila::Spectrogram powers(frames, Aquila::Spectrogram::PowerStorage);
+        Aquila::Spectrogram decibels(frames, Aquila::Spectrogram::DecibelStorage);
+
+        for (std::size_t x = 0; x < complexSpectrogram.getFrameCount(); ++x)
+        {
+            for (std::size_t y = 0; y < complexSpectrogram.getBinCount(); ++y)
+            {
+                auto point = complexSpectrogram.getPoint(x, y);
+                double magnitude = std::abs(point);
+                CHECK_CLOSE(magnitude, magnitudes.getValue(x, y), 0.0001);
+                CHECK_CLOSE(magnitude * magnitude, powers.getValue(x, y), 0.001);
+                if (magnitude > 0.001)
+                {
+                    CHECK_CLOSE(Aquila::dB(point), decibels.getValue(x, y), 0.001);
+                }
+                CHECK_EQUAL(magnitudes.getValue(x, y),
+                            magnitudes.getValueColumn(y)[x]);
+                CHECK_EQUAL(powers.getValue(x, y), powers.getValueRow(x)[y]);
+            }
+        }
+    }
+
+    TEST(ThreadCountDoesNotChangeResult)
+    {
+        Aquila::SineGenerator generator(sampleFrequency);
+        generator.setFrequency(100).setAmplitude(1).generate(SIZE);
+        Aquila::FramesCollection frames(generator, 16);
+
+        Aquila::Spectrogram serial(frames, Aquila::Spectrogram::ComplexStorage, 1);
+        Aquila::Spectrogram parallel(frames, Aquila::Spectrogram::ComplexStorage, 4);
+        Aquila::Spectrogram serialPower(frames, Aquila::Spectrogram::PowerStorage, 1);
+        Aquila::Spectrogram parallelPower(frames, Aquila::Spectrogram::PowerStorage, 3);
+
+        CHECK_EQUAL(serial.getFrameCount(), parallel.getFrameCount());
+        for (std::size_t x = 0; x < serial.getFrameCount(); ++x)
+        {
+            for (std::size_t y = 0; y < serial.getBinCount(); ++y)
+            {
+                CHECK(serial.getPoint(x, y) == parallel.getPoint(x, y));
+                CHECK_EQUAL(serialPower.getValue(x, y),
+                            parallelPower.getValue(x, y));
+            }
+        }
+    }
+
+    TEST(FrameViewsSameAsCollection)
+    {
+        Aquila::SineGenerator generator(sampleFrequency);
+        generator.setFrequency(100).setAmplitude(1).generate(SIZE);
+        Aquila::FramesCollection frames(generator, 64, 16);
+        Aquila::FrameViews views(generator, 64, 16);
+
+        Aquila::Spectrogram fromFrames(frames);
+        Aquila::Spectrogram fromViews(views);
+
+        CHECK_EQUAL(fromFrames.getFrameCount(), fromViews.getFrameCount());
+        CHECK_EQUAL(fromFrames.getSpectrumSize(), fromViews.getSpectrumSize());
+        for (std::size_t x = 0; x < fromFrames.getFrameCount(); ++x)
+        {
+            for (std::size_t y = 0; y < fromFrames.getBinCount(); ++y)
+            {
+                CHECK(fromFrames.getPoint(x, y) == fromViews.getPoint(x, y));
+            }
+        }
+    }
 }
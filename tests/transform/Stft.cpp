@@ -0,0 +1,92 @@
+#include "aquila/global.h"
+#include "aquila/Exceptions.h"
+#include "aquila/source/generator/SineGenerator.h"
+#include "aquila/source/window/HammingWindow.h"
+#include "aquila/source/window/HannWindow.h"
+#include "aquila/transform/FftFactory.h"
+#include "aquila/transform/Stft.h"
+#include "UnitTest++/UnitTest++.h"
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+
+SUITE(Stft)
+{
+    const std::size_t SIZE = 1000;
+    Aquila::FrequencyType sampleFrequency = 1024;
+
+    TEST(FrameCount)
+    {
+        Aquila::Stft stft(256, 64);
+        CHECK_EQUAL(0u, stft.getFrameCount(100));
+        CHECK_EQUAL(1u, stft.getFrameCount(256));
+        CHECK_EQUAL(1u, stft.getFrameCount(319));
+        CHECK_EQUAL(2u, stft.getFrameCount(320));
+        CHECK_EQUAL(129u, stft.getBinCount());
+    }
+
+    TEST(ZeroHopThrows)
+    {
+        const std::size_t hop = 0;
+        CHECK_THROW(Aquila::Stft stft(256, hop), Aquila::Exception);
+    }
+
+    TEST(WindowTablesAreCached)
+    {
+        Aquila::Stft first(128, 32, Aquila::Stft::Hamming);
+        Aquila::Stft second(128, 64, Aquila::Stft::Hamming);
+        CHECK(&first.getWindowTable() == &second.getWindowTable());
+        CHECK(Aquila::Stft::getWindow(Aquila::Stft::Hann, 128) !=
+              Aquila::Stft::getWindow(Aquila::Stft::Hamming, 128));
+
+        Aquila::HammingWindow window(128);
+        CHECK_ARRAY_CLOSE(window.toArray(), first.getWindowTable(), 128, 0.000001);
+    }
+
+    TEST(SameAsWindowedFft)
+    {
+        const std::size_t FRAME = 128, HOP = 48;
+        Aquila::SineGenerator generator(sampleFrequency);
+        generator.setFrequency(100).setAmplitude(1).generate(SIZE);
+
+        Aquila::Stft stft(FRAME, HOP, Aquila::Stft::Hann);
+        auto spectra = stft.transform(generator);
+        const std::size_t count = stft.getFrameCount(SIZE);
+        CHECK_EQUAL(count * stft.getBinCount(), spectra.size());
+
+        Aquila::HannWindow window(FRAME);
+        auto fft = Aquila::FftFactory::getFft(FRAME);
+        std::vector<Aquila::SampleType> frame(FRAME);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            for (std::size_t n = 0; n < FRAME; ++n)
+            {
+                frame[n] = generator.sample(i * HOP + n) * window.sample(n);
+            }
+            auto expected = fft->fft(frame.data());
+            for (std::size_t k = 0; k < stft.getBinCount(); ++k)
+            {
+                const Aquila::ComplexType& actual = spectra[i * stft.getBinCount() + k];
+                CHECK_CLOSE(expected[k].real(), actual.real(), 0.0001);
+                CHECK_CLOSE(expected[k].imag(), actual.imag(), 0.0001);
+            }
+        }
+    }
+
+    TEST(ThreadCountDoesNotChangeResult)
+    {
+        Aquila::SineGenerator generator(sampleFrequency);
+        generator.setFrequency(200).setAmplitude(1).generate(SIZE);
+
+        Aquila::Stft stft(64, 16, Aquila::Stft::Blackman);
+        auto serial = stft.transform(generator, 1);
+        auto parallel = stft.transform(generator, 4);
+
+        CHECK_EQUAL(serial.size(), parallel.size());
+        for (std::size_t i = 0; i < serial.size(); ++i)
+        {
+            CHECK(serial[i] == parallel[i]);
+        }
+    }
+}
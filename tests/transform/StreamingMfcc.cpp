@@ -0,0 +1,162 @@
+#include "aquila/global.h"
+#include "aquila/Exceptions.h"
+#include "aquila/source/FramesCollection.h"
+#include "aquila/source/generator/SineGenerator.h"
+#include "aquila/transform/Mfcc.h"
+#include "aquila/transform/StreamingMfcc.h"
+#include "UnitTest++/UnitTest++.h"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+    const std::size_t NUM_FEATURES = 12, FRAME_SIZE = 256, HOP_SIZE = 100;
+    const std::size_t DELTA_WINDOW = 2;
+
+    /**
+     * Calculates deltas of a sequence of vectors, replicating edges.
+     */
+    std::vector<double> offlineDeltas(const std::vector<double>& values,
+                                      std::size_t frames)
+    {
+        std::vector<double> deltas(values.size(), 0.0);
+        const long last = static_cast<long>(frames) - 1;
+        for (long t = 0; t <= last; ++t)
+        {
+            double norm = 0.0;
+            for (long n = 1; n <= static_cast<long>(DELTA_WINDOW); ++n)
+            {
+                const long plus = std::min(t + n, last);
+                const long minus = std::max(t - n, 0L);
+                for (std::size_t i = 0; i < NUM_FEATURES; ++i)
+                {
+                    deltas[t * NUM_FEATURES + i] += n *
+                        (values[plus * NUM_FEATURES + i] -
+                         values[minus * NUM_FEATURES + i]);
+                }
+                norm += 2.0 * n * n;
+            }
+            for (std::size_t i = 0; i < NUM_FEATURES; ++i)
+            {
+                deltas[t * NUM_FEATURES + i] /= norm;
+            }
+        }
+        return deltas;
+    }
+
+    /**
+     * Streams the signal in blocks of given size, returns all features.
+     */
+    std::vector<double> streamFeatures(const Aquila::SignalSource& source,
+                                       std::size_t blockSize,
+                                       std::vector<std::size_t>& indices)
+    {
+        Aquila::StreamingMfcc mfcc(source.getSampleFrequency(), FRAME_SIZE,
+                                   HOP_SIZE, NUM_FEATURES, DELTA_WINDOW);
+        std::vector<double> features;
+        auto collect = [&] (const double* values, std::size_t frame) {
+            features.insert(features.end(), values,
+                            values + mfcc.getFeatureVectorSize());
+            indices.push_back(frame);
+        };
+        for (std::size_t i = 0; i < source.length(); i += blockSize)
+        {
+            std::size_t count = std::min(blockSize, source.length() - i);
+            mfcc.process(source.toArray() + i, count, collect);
+        }
+        mfcc.flush(collect);
+        return features;
+    }
+}
+
+
+SUITE(StreamingMfcc)
+{
+    TEST(ZeroHopThrows)
+    {
+        const std::size_t hop = 0;
+        CHECK_THROW(Aquila::StreamingMfcc mfcc(8000, 256, hop), Aquila::Exception);
+    }
+
+    TEST(ZeroDeltaWindowThrows)
+    {
+        const std::size_t numFeatures = 12, deltaWindow = 0;
+        CHECK_THROW(Aquila::StreamingMfcc mfcc(8000, 256, 128, numFeatures, deltaWindow),
+                    Aquila::Exception);
+    }
+
+    TEST(SameAsOffline)
+    {
+        Aquila::SineGenerator generator(8000);
+        generator.setAmplitude(1000).setFrequency(300).generate(3000);
+        Aquila::FramesCollection frames(generator, FRAME_SIZE,
+                                        FRAME_SIZE - HOP_SIZE);
+        Aquila::Mfcc offline(FRAME_SIZE);
+        auto statics = offline.calculateAll(frames, NUM_FEATURES);
+        auto deltas = offlineDeltas(statics, frames.count());
+        auto deltaDeltas = offlineDeltas(deltas, frames.count());
+
+        const std::size_t blockSizes[] = {1, 37, 100, 512, 3000};
+        for (std::size_t blockSize : blockSizes)
+        {
+            std::vector<std::size_t> indices;
+            auto features = streamFeatures(generator, blockSize, indices);
+
+            CHECK_EQUAL(frames.count(), indices.size());
+            CHECK_EQUAL(3 * NUM_FEATURES * frames.count(), features.size());
+            for (std::size_t t = 0; t < indices.size(); ++t)
+            {
+                CHECK_EQUAL(t, indices[t]);
+                const double* row = &features[t * 3 * NUM_FEATURES];
+                CHECK_ARRAY_CLOSE(&statics[t * NUM_FEATURES], row,
+                                  NUM_FEATURES, 0.000001);
+                CHECK_ARRAY_CLOSE(&deltas[t * NUM_FEATURES],
+                                  row + NUM_FEATURES, NUM_FEATURES, 0.000001);
+                CHECK_ARRAY_CLOSE(&deltaDeltas[t * NUM_FEATURES],
+                                  row + 2 * NUM_FEATURES, NUM_FEATURES, 0.000001);
+            }
+        }
+    }
+
+    TEST(BoundedLatency)
+    {
+        Aquila::StreamingMfcc mfcc(8000, FRAME_SIZE, HOP_SIZE, NUM_FEATURES,
+                                   DELTA_WINDOW);
+        std::vector<Aquila::SampleType> block(HOP_SIZE, 1.0);
+        std::size_t emitted = 0;
+        auto count = [&] (const double*, std::size_t) { ++emitted; };
+
+        // first frame completes after FRAME_SIZE samples, then every hop;
+        // features are emitted 2 * DELTA_WINDOW frames later
+        std::size_t samples = 0;
+        for (int i = 0; i < 20; ++i)
+        {
+            mfcc.process(block, count);
+            samples += HOP_SIZE;
+            std::size_t frames = samples < FRAME_SIZE ? 0 :
+                (samples - FRAME_SIZE) / HOP_SIZE + 1;
+            std::size_t expected = frames > 2 * DELTA_WINDOW ?
+                frames - 2 * DELTA_WINDOW : 0;
+            CHECK_EQUAL(expected, emitted);
+            CHECK_EQUAL(expected, mfcc.getEmittedCount());
+        }
+    }
+
+    TEST(FlushResets)
+    {
+        Aquila::StreamingMfcc mfcc(8000, FRAME_SIZE, HOP_SIZE, NUM_FEATURES);
+        std::vector<Aquila::SampleType> block(1000, 1.0);
+        std::size_t emitted = 0;
+        auto count = [&] (const double*, std::size_t) { ++emitted; };
+
+        mfcc.process(block, count);
+        mfcc.flush(count);
+        CHECK_EQUAL(8u, emitted);
+        CHECK_EQUAL(0u, mfcc.getEmittedCount());
+
+        emitted = 0;
+        mfcc.flush(count);
+        CHECK_EQUAL(0u, emitted);
+    }
+}